@@ -3,8 +3,10 @@ set(C_SRC
 	alloc.c
 	anim.c
 	assets.c
+	bench.c
 	bsp.c
 	bsp_parse.c
+	bsp_cook.c
 	camera.c
 	controls.c
 	cull.c
@@ -13,6 +15,7 @@ set(C_SRC
 	ecs.c
 	engine.c
 	game.c
+	lightprobe.c
 	palette.c
 	particle.c
 	phys.c
@@ -122,6 +125,7 @@ set(ASM_SRC
 	)
 
 set(TOS_SRC
+	planar.c
 	tosfb.c
 	x86_64/isr_pit.s
 	)
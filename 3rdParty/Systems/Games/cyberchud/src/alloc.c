@@ -65,3 +65,51 @@ void bfree(alloc_t* alloc, void* ptr) {
 	const size_t idx = *nptr;
 	buddy_free(alloc->pages[idx], nptr);
 }
+
+static int pool_new_chunk(pool_t* pool) {
+	char* const mem = aligned_alloc(64, pool->slot_size*pool->chunk_slots);
+	if (mem == NULL) {
+		myprintf("[pool_new_chunk] failed to aligned_alloc: %lu\n", pool->slot_size*pool->chunk_slots);
+		return 1;
+	}
+	arrput(pool->chunks, mem);
+	/* thread the free list back to front so slots get handed out in address order */
+	for (size_t i=pool->chunk_slots; i-- > 0;) {
+		void** const slot = (void**)&mem[i*pool->slot_size];
+		*slot = pool->free_list;
+		pool->free_list = slot;
+	}
+	return 0;
+}
+
+int pool_init(pool_t* pool, size_t slot_size, size_t chunk_slots) {
+#ifndef NDEBUG
+	myprintf("[pool_init] slot_size:%lu chunk_slots:%lu\n", slot_size, chunk_slots);
+#endif
+	pool->slot_size = (slot_size+63) & ~(size_t)63;
+	pool->chunk_slots = chunk_slots;
+	pool->chunks = NULL;
+	pool->free_list = NULL;
+	return pool_new_chunk(pool);
+}
+
+void* pool_alloc(pool_t* pool) {
+	if (pool->free_list == NULL && pool_new_chunk(pool))
+		return NULL;
+	void** const slot = pool->free_list;
+	pool->free_list = *slot;
+	return slot;
+}
+
+void pool_free(pool_t* pool, void* ptr) {
+	void** const slot = ptr;
+	*slot = pool->free_list;
+	pool->free_list = slot;
+}
+
+void pool_destroy(pool_t* pool) {
+	for (size_t i=0; i<arrlenu(pool->chunks); i++)
+		free(pool->chunks[i]);
+	arrfree(pool->chunks);
+	pool->free_list = NULL;
+}
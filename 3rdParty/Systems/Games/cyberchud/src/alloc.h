@@ -9,8 +9,21 @@ typedef struct {
 	struct buddy** pages;
 } alloc_t;
 
+/* Fixed size slots carved out of contiguous chunks, freed slots get reused first */
+typedef struct {
+	size_t slot_size;
+	size_t chunk_slots;
+	char** chunks;
+	void* free_list;
+} pool_t;
+
 int alloc_init(alloc_t* alloc, size_t alignment, size_t page_size);
 void* balloc(alloc_t* alloc, size_t size);
 void bfree(alloc_t* alloc, void* ptr);
 
+int pool_init(pool_t* pool, size_t slot_size, size_t chunk_slots);
+void* pool_alloc(pool_t* pool);
+void pool_free(pool_t* pool, void* ptr);
+void pool_destroy(pool_t* pool);
+
 #endif
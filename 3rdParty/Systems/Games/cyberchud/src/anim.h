@@ -7,6 +7,10 @@
 #define MAX_BONE_CHILDREN 16
 #define MAX_BONE_INFLUENCE 4
 
+/* Animation LOD, past these camera distances poses update every 2nd/4th frame */
+#define ANIM_LOD_NEAR 12.0f
+#define ANIM_LOD_FAR 24.0f
+
 typedef struct {
 	float time;
 	vec3s pos;
@@ -42,14 +46,25 @@ typedef struct {
 	mat4s inv_matrix;
 } bone_data_t;
 
+/* Skinned vertex in model space, every mesh of the model back to back */
+typedef struct {
+	vec3s pos;
+	vec3s norm;
+	vec3s tangent;
+} skin_vert_t;
+
 typedef struct {
 	uint32_t frame;
 	float time;
 	float length;
 	uint32_t bone_mtx_sz;
+	uint32_t skin_sz;
+	unsigned int skinned : 1; // skin holds a pose
+	float lod_delta; // time banked while animation LOD skipped this model
 	const anim_data_t* data;
 	const anim_data_t* next;
 	mat4s* bone_mtx;
+	skin_vert_t* skin;
 } anim_t;
 
 void bone_update(anim_t *anim, const uint32_t bone_cnt, const float delta);
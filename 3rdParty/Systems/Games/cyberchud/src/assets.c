@@ -4,6 +4,9 @@
 #include "text.h"
 #include "wad.h"
 #include "bsp_parse.h"
+#include "bsp_cook.h"
+#include "mytime.h"
+#include "stb_sprintf.h"
 #include "sound.h"
 #include "utils/mymalloc.h"
 #include "utils/pad.h"
@@ -26,16 +29,12 @@ static int lookup_gray_px(const char* const material) {
 	return -1;
 }
 
-static inline const char* get_data(const char* const data, const WAD_IDX idx) {
-	return data+g_wad[idx].pos;
-}
-
-static void load_notes(const char* const data, const pitch_data_t* snds[]) {
+static void load_notes(const wad_t* const wad, const pitch_data_t* snds[]) {
 #ifndef NDEBUG
 	myprintf("[load_notes]\n");
 #endif
 	for (uint32_t i=0; i<SND_TOTAL; i++) {
-		snds[i] = (const pitch_data_t*)get_data(data, SND_FILES[i]);
+		snds[i] = (const pitch_data_t*)wad_lump(wad, SND_FILES[i]);
 #ifndef NDEBUG
 		myprintf("[load_notes] %u len:%u dur:%.2f\n", i, snds[i]->len, snds[i]->duration);
 #endif
@@ -243,8 +242,6 @@ static const char* model_anim_parse(const char* data, model_anim_data_t* model,
 	return data;
 }
 
-wad_t wad = {0};
-
 #if 0
 static int load_font(wad_t* wad, font_t* font, int font_height, int font_space, const int8_t* const font_y, const WAD_IDX idx) {
 	myprintf("[load_font] idx:%d\n", idx);
@@ -271,7 +268,7 @@ static int load_font(wad_t* wad, font_t* font, int font_height, int font_space,
 }
 #endif
 
-static void load_font(const char* const data, font_t* font, int font_height, int font_space, const int8_t* const font_y, const WAD_IDX idx) {
+static void load_font(const wad_t* const wad, font_t* font, int font_height, int font_space, const int8_t* const font_y, const WAD_IDX idx) {
 #ifndef NDEBUG
 	myprintf("[load_font] idx:%d\n", idx);
 #endif
@@ -279,46 +276,133 @@ static void load_font(const char* const data, font_t* font, int font_height, int
 	font->space_width = font_space;
 	memcpy(font->font_y, font_y, GLYPH_TOTAL);
 	for (size_t i=0; i<GLYPH_TOTAL; i++) {
-		font->glyph[i] = (const px_t*)get_data(data, idx+i);
+		font->glyph[i] = (const px_t*)wad_lump(wad, idx+i);
 #ifdef VERBOSE
 		myprintf("[FONT] [%d] %dx%d\n", idx+i, font->glyph[i]->h, font->glyph[i]->w);
 #endif
 	}
 }
 
-int assets_load_level(assets_t* const assets, alloc_t* const alloc, int level_num) {
-	level_num *= 2; // assets are sorted BSP/LUX...
-	if (bsp_parse((char*)get_data(assets->data, BSP_FILES[level_num]), &assets->map, (const bsp_lux_t*)get_data(assets->data, BSP_FILES[level_num+1]), assets, alloc))
+/* Waits on the lumps, hashes them and runs bsp_transform the first time round, returns the BSP or NULL */
+static char* assets_level_lumps(assets_t* const assets, const int level_num, int* const first_load) {
+	const WAD_IDX bsp_idx = BSP_FILES[level_num*2]; // assets are sorted BSP/LUX...
+	const WAD_IDX lux_idx = BSP_FILES[level_num*2+1];
+	/* levels other than the title may still be streaming in */
+	if (wad_wait(&assets->wad, bsp_idx) || wad_wait(&assets->wad, lux_idx)) {
+		myprintf("[ERR] [assets_load_level] level:%d failed to load\n", level_num);
+		return NULL;
+	}
+	char* const bsp = (char*)wad_lump(&assets->wad, bsp_idx);
+	*first_load = !assets->bsp_transformed[level_num];
+	if (*first_load) {
+#ifdef BSP_COOK
+		const bsp_lux_t* const lux = (const bsp_lux_t*)wad_lump(&assets->wad, lux_idx);
+		assets->bsp_hash[level_num] = bsp_cook_hash(bsp, g_wad[bsp_idx].size, lux, g_wad[lux_idx].size);
+#endif
+		bsp_transform(bsp);
+		assets->bsp_transformed[level_num] = 1;
+	}
+	return bsp;
+}
+
+int assets_load_level(assets_t* const assets, alloc_t* const alloc, const int level_num) {
+	const TIME_TYPE start = get_time();
+	const WAD_IDX lux_idx = BSP_FILES[level_num*2+1];
+	int first_load;
+	char* const bsp = assets_level_lumps(assets, level_num, &first_load);
+	if (bsp == NULL)
+		return 1;
+	const bsp_lux_t* const lux = (const bsp_lux_t*)wad_lump(&assets->wad, lux_idx);
+
+	int cooked = 0;
+#ifdef BSP_COOK
+	const WAD_IDX bsp_idx = BSP_FILES[level_num*2];
+	char path[32];
+	stbsp_snprintf(path, sizeof(path), BSP_COOK_PATH, level_num);
+	cooked = !bsp_cook_load(path, assets->bsp_hash[level_num], bsp, g_wad[bsp_idx].size, lux, g_wad[lux_idx].size, &assets->map, assets, alloc);
+#endif
+	if (!cooked && bsp_parse(bsp, &assets->map, lux, assets, alloc))
 		return 1;
+	/* the lux lump is patched in place, a reload would flip it back */
+	if (first_load)
+		bsp_luxmap_fix(&assets->map);
+	myprintf("[assets_load_level] level:%d %s in %.2fms\n", level_num, cooked ? "cooked" : "parsed", time_diff(start, get_time())*1000.0f);
 	return 0;
 }
 
+#ifdef BSP_COOK
+/* Parses every level and dumps the result next to data.wad, see bsp_cook.h */
+int assets_cook_levels(assets_t* const assets, alloc_t* const alloc) {
+	for (int level_num=0; level_num<BSP_TOTAL/2; level_num++) {
+		const WAD_IDX bsp_idx = BSP_FILES[level_num*2];
+		const WAD_IDX lux_idx = BSP_FILES[level_num*2+1];
+		int first_load;
+		char* const bsp = assets_level_lumps(assets, level_num, &first_load);
+		if (bsp == NULL)
+			return 1;
+		const bsp_lux_t* const lux = (const bsp_lux_t*)wad_lump(&assets->wad, lux_idx);
+		if (bsp_parse(bsp, &assets->map, lux, assets, alloc))
+			return 1;
+		if (first_load)
+			bsp_luxmap_fix(&assets->map);
+		char path[32];
+		stbsp_snprintf(path, sizeof(path), BSP_COOK_PATH, level_num);
+		if (bsp_cook_write(path, assets->bsp_hash[level_num], &assets->map, bsp, g_wad[bsp_idx].size, lux, g_wad[lux_idx].size, assets))
+			return 1;
+	}
+	return 0;
+}
+#endif
+
 static inline const px_t* parse_px(assets_t *assets, const WAD_IDX idx) {
 #ifdef VERBOSE
 	myprintf("[parse_px] assets:0x%p\n", assets);
 #endif
-	const px_t* const px = (const px_t*)get_data(assets->data, idx);
+	const px_t* const px = (const px_t*)wad_lump(&assets->wad, idx);
 #ifdef VERBOSE
 	myprintf("[parse_px] assets:0x%p px:0x%p\n", assets, px);
 #endif
 	return px;
 }
 
+static inline int is_streamed(const uint32_t idx) {
+	for (int i=0; i<BSP_TOTAL/2; i++) {
+		if (i == ASSETS_TITLE_LEVEL)
+			continue;
+		if (BSP_FILES[i*2] == idx || BSP_FILES[i*2+1] == idx)
+			return 1;
+	}
+	return 0;
+}
+
+/* Opens the WAD and queues every compressed lump the title needs,
+ * the caller runs JOB_STATE_WAD to decompress them before assets_init. */
+int assets_open(assets_t* const assets) {
+	static uint32_t queue[WAD_TOTAL];
+#ifndef NDEBUG
+	myprintf("[assets_open] assets_ptr:0x%lx\n", assets);
+#endif
+	if (wad_init(&assets->wad, "data.wad"))
+		return 1;
+	memset(assets->bsp_transformed, 0, sizeof(assets->bsp_transformed));
+
+	uint32_t cnt = 0;
+	for (uint32_t i=0; i<WAD_TOTAL; i++) {
+		if (g_wad[i].size_compressed && !is_streamed(i))
+			queue[cnt++] = i;
+	}
+	wad_queue(&assets->wad, queue, cnt);
+	return 0;
+}
+
 int assets_init(assets_t* const assets, alloc_t* const alloc) {
 #ifndef NDEBUG
 	myprintf("[assets_init] assets_ptr:0x%lx\n", assets);
 #endif
-	int ret = wad_init(&wad, "data.wad");
-	if (ret) return ret;
-
-	char* data = mymalloc(WAD_GLOB_SIZE);
-	if (data == NULL) {
-		myprintf("[ERR] [assets_init] FAILED TO MALLOC bytes:%lu\n", WAD_GLOB_SIZE);
+	if (assets->wad.error) {
+		myprintf("[ERR] [assets_init] failed to decompress data.wad\n");
 		return 1;
 	}
-	wad_get_glob(&wad, data);
-
-	assets->data = data;
 
 	/* Load Px */
 	for (uint32_t i=0; i<PX_RGB_TOTAL; i++) {
@@ -333,37 +417,42 @@ int assets_init(assets_t* const assets, alloc_t* const alloc) {
 
 	/* Load Static Models */
 	for (uint32_t i=0; i<MODELS_STATIC_TOTAL; i++) {
-		if (!parse_model_basic(get_data(assets->data, MODELS_STATIC_FILES[i]), &assets->models_basic[i], assets, alloc, 0)) {
+		if (!parse_model_basic(wad_lump(&assets->wad, MODELS_STATIC_FILES[i]), &assets->models_basic[i], assets, alloc, 0)) {
 			return 1;
 		}
 	}
 
 	/* Load Animated Models */
 	for (uint32_t i=0; i<MODELS_ANIM_TOTAL; i++) {
-		if (!model_anim_parse(get_data(assets->data, MODELS_ANIM_FILES[i]), &assets->models_anim[i], assets, alloc))
+		if (!model_anim_parse(wad_lump(&assets->wad, MODELS_ANIM_FILES[i]), &assets->models_anim[i], assets, alloc))
 			return 1;
 	}
 
 	/* Load Sounds */
-	load_notes(assets->data, assets->snds);
-
-	/* Transform BSP */
-	for (int i=0; i<BSP_TOTAL/2; i++) {
-		bsp_transform((char*)get_data(assets->data, BSP_FILES[i*2]));
-	}
+	load_notes(&assets->wad, assets->snds);
 
 	/* Matchup */
 	const int8_t matchup_y[GLYPH_TOTAL] = {1,1,3,1,3,3,1,1,1,4,4,8,5,8,3,2,2,2,2,2,2,2,2,2,2,5,6,4,4,4,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,1,3,1,0,9,1,4,2,4,2,4,2,4,2,2,2,2,2,4,4,4,4,4,4,4,2,4,4,4,4,4,4,1,2,1,3};
-	load_font(assets->data, &assets->font_matchup, 12, 6, matchup_y, WAD_FONTS_MATCHUP_033_BIN);
+	load_font(&assets->wad, &assets->font_matchup, 12, 6, matchup_y, WAD_FONTS_MATCHUP_033_BIN);
 
 	const int8_t pinzelan_y[GLYPH_TOTAL] = {2,2,4,3,6,4,2,1,1,2,6,17,10,16,3,3,4,4,3,2,3,3,4,3,2,8,8,9,8,8,1,4,3,3,4,4,4,3,4,4,4,3,3,3,4,3,4,2,5,3,3,4,4,4,5,5,4,5,4,3,4,1,19,1,3,3,4,4,4,3,4,4,4,3,3,3,4,3,4,2,5,3,3,4,4,4,5,5,4,5,2,0,2,8};
-	load_font(assets->data, &assets->font_pinzelan, 24, 8, pinzelan_y, WAD_FONTS_PINZELAN_033_BIN);
+	load_font(&assets->wad, &assets->font_pinzelan, 24, 8, pinzelan_y, WAD_FONTS_PINZELAN_033_BIN);
 
 	/* static const int fontHeight = 53; */
 	const int8_t pinzelan2x_y[GLYPH_TOTAL] = {4,5,9,7,13,10,5,3,3,4,14,38,23,36,7,7,10,10,7,5,7,6,8,8,6,18,18,19,18,18,3,10,7,7,9,8,10,8,9,10,9,6,6,6,10,6,8,6,10,7,7,9,10,10,11,11,9,10,9,8,9,2,42,2,7,7,9,8,10,8,9,10,9,6,6,6,10,6,8,6,10,7,7,9,10,10,11,11,9,10,4,0,4,17};
-	load_font(assets->data, &assets->font_pinzelan2x, 53, 12, pinzelan2x_y, WAD_FONTS_PINZELAN2X_033_BIN);
-
-	wad_free(&wad);
+	load_font(&assets->wad, &assets->font_pinzelan2x, 53, 12, pinzelan2x_y, WAD_FONTS_PINZELAN2X_033_BIN);
+
+	/* The remaining levels decompress in the background while the title runs */
+	uint32_t stream[WAD_TOTAL];
+	uint32_t stream_cnt = 0;
+	for (uint32_t i=0; i<WAD_TOTAL; i++) {
+		if (g_wad[i].size_compressed && is_streamed(i))
+			stream[stream_cnt++] = i;
+	}
+	if (wad_stream(&assets->wad, stream, stream_cnt)) {
+		myprintf("[ERR] [assets_init] can't start wad stream\n");
+		return 1;
+	}
 	return 0;
 }
 
@@ -371,7 +460,7 @@ int assets_free(assets_t *assets) {
 #ifndef NDEBUG
 	myprintf("[assets_free] %p\n", assets);
 #endif
-	myfree((void*)assets->data);
+	wad_free(&assets->wad);
 #ifndef NDEBUG
 	fputs("[assets_free] done\n", stdout);
 #endif
@@ -8,6 +8,8 @@
 #include "sound.h"
 #include "px.h"
 
+#define ASSETS_TITLE_LEVEL (WAD_BSP_LEVELTITLE_BSP/2)
+
 typedef struct {
 	const char* name;
 	const i16* diffuse;
@@ -17,7 +19,9 @@ typedef struct {
 } material_info_t;
 
 typedef struct {
-	const char* data;
+	wad_t wad;
+	u8 bsp_transformed[BSP_TOTAL/2]; // bsp_transform patches in place, only once per level
+	u32 bsp_hash[BSP_TOTAL/2]; // bsp_cook_hash of the lumps as they came out of the WAD
 	model_basic_t models_basic[MODELS_STATIC_TOTAL];
 	model_anim_data_t models_anim[MODELS_ANIM_TOTAL];
 	const px_t* px_rgb[PX_RGB_TOTAL];
@@ -30,8 +34,10 @@ typedef struct {
 	const pitch_data_t* snds[SND_TOTAL];
 } assets_t;
 
+int assets_open(assets_t* const assets);
 int assets_init(assets_t* const assets, alloc_t* const alloc);
 int assets_free(assets_t *assets);
-int assets_load_level(assets_t* const assets, alloc_t* const alloc, int level_num);
+int assets_load_level(assets_t* const assets, alloc_t* const alloc, const int level_num);
+int assets_cook_levels(assets_t* const assets, alloc_t* const alloc);
 
 #endif
@@ -0,0 +1,198 @@
+#include <string.h>
+
+#include "bench.h"
+#include "mytime.h"
+#include "text.h"
+#include "stb_sprintf.h"
+
+static const char* const PHASE_NAMES[] = {"edict", "particle", "cull", "bones", "verts", "shadow", "frag", "present", "total"};
+#define PHASE_CNT (sizeof(PHASE_NAMES)/sizeof(PHASE_NAMES[0]))
+_Static_assert(PHASE_CNT == BENCH_PHASE_CNT, "bench_t.totals is sized by BENCH_PHASE_CNT");
+
+/* FNV-1a, only needs to be stable across builds */
+static u64 fb_hash(const u8* const fb, const size_t len) {
+	u64 hash = 0xcbf29ce484222325ull;
+	for (size_t i=0; i<len; i++) {
+		hash ^= fb[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+static int ends_with(const char* const str, const char* const suffix) {
+	const size_t len = strlen(str);
+	const size_t suffix_len = strlen(suffix);
+	return len >= suffix_len && strcmp(&str[len-suffix_len], suffix) == 0;
+}
+
+int bench_init(bench_t* const b, const init_cfg_t* const cfg) {
+	b->level = cfg->use_level ? cfg->level : -1;
+	b->frames_max = cfg->frames;
+	b->particles = cfg->particles;
+	b->mobs = cfg->mobs;
+	b->hash = 0xcbf29ce484222325ull;
+
+	if (cfg->demo_play) {
+		b->demo_in = fopen(cfg->demo_play, "rb");
+		if (!b->demo_in) {
+			myprintf("[ERR] [bench_init] can't open demo %s\n", cfg->demo_play);
+			return 1;
+		}
+		demo_header_t header;
+		if (fread(&header, sizeof(header), 1, b->demo_in) != 1 || header.magic != DEMO_MAGIC
+		|| header.version != DEMO_VERSION || header.controls_size != sizeof(controls_t)) {
+			myprintf("[ERR] [bench_init] %s isn't a demo from this build\n", cfg->demo_play);
+			return 1;
+		}
+		b->level = header.level;
+	}
+
+	if (cfg->demo_record) {
+		b->demo_out = fopen(cfg->demo_record, "wb");
+		if (!b->demo_out) {
+			myprintf("[ERR] [bench_init] can't open %s for writing\n", cfg->demo_record);
+			return 1;
+		}
+		const demo_header_t header = {
+			.magic = DEMO_MAGIC,
+			.version = DEMO_VERSION,
+			.controls_size = sizeof(controls_t),
+			.level = b->level,
+		};
+		fwrite(&header, sizeof(header), 1, b->demo_out);
+	}
+
+	if (cfg->bench_out) {
+		b->out = fopen(cfg->bench_out, "w");
+		if (!b->out) {
+			myprintf("[ERR] [bench_init] can't open %s for writing\n", cfg->bench_out);
+			return 1;
+		}
+		b->json = ends_with(cfg->bench_out, ".json");
+		if (b->json) {
+			fputs("{\"frames\":[\n", b->out);
+		} else {
+			fputs("frame", b->out);
+			for (size_t i=0; i<PHASE_CNT; i++)
+				fprintf(b->out, ",%s", PHASE_NAMES[i]);
+			fputs(",hash\n", b->out);
+		}
+	}
+	return 0;
+}
+
+/* Replaces input() during playback, returns 0 once the demo ran out */
+int bench_input(bench_t* const b, controls_t* const c) {
+	if (fread(c, sizeof(controls_t), 1, b->demo_in) != 1) {
+		b->done = 1;
+		return 0;
+	}
+	return 1;
+}
+
+void bench_record(bench_t* const b, const controls_t* const c) {
+	fwrite(c, sizeof(controls_t), 1, b->demo_out);
+}
+
+/* Fills a square around the player, the mobs chase it so SV_Move and the broadphase show up as the edict column */
+static void bench_spawn_mobs(bench_t* const b, engine_t* const e) {
+	const vec3s center = e->ecs.pos[e->ecs.player_id];
+	const float spacing = 2.0f;
+	const i32 side = (i32)ceilf(sqrtf(b->mobs+1));
+	for (i32 i=0, cnt=0; cnt<b->mobs; i++) {
+		const i32 x = i%side - side/2;
+		const i32 z = i/side - side/2;
+		if (x == 0 && z == 0)
+			continue;
+		const vec3s pos = {{center.x + x*spacing, center.y, center.z + z*spacing}};
+		new_chud(e, pos, 0, CHUD_TASK_NONE);
+		cnt++;
+	}
+	b->mobs_spawned = 1;
+}
+
+/* Tops the particle pool back up, the sim cost then shows up as the particle column */
+void bench_tick(bench_t* const b, engine_t* const e) {
+	if (e->scene != SCENE_PLAYFIELD)
+		return;
+	if (b->mobs && !b->mobs_spawned)
+		bench_spawn_mobs(b, e);
+	ecs_t* const ecs = &e->ecs;
+	const vec3s center = ecs->pos[ecs->player_id];
+	while (ecs->particles.cnt < b->particles) {
+		vec3s pos, vel;
+		rand_vec3(&e->seed, vel.raw);
+		glm_vec3_scale(vel.raw, 0.5f, pos.raw);
+		glm_vec3_add(pos.raw, (float*)center.raw, pos.raw);
+		glm_vec3_scale(vel.raw, 5.0f, vel.raw);
+		if (new_particle(ecs, &pos, &vel, &e->assets.models_basic[MODELS_STATIC_CUBE], 0) < 0)
+			break;
+	}
+}
+
+/* Headless stand-in for the window blit, same palette expand the software path does */
+float bench_present(bench_t* const b, const engine_t* const e) {
+	const TIME_TYPE start = get_time();
+	for (size_t i=0; i<SCREEN_W*SCREEN_H; i++)
+		b->swiz[i] = e->palette.colors[e->fb_real[i]].rgba;
+	return time_diff(start, get_time())*1000;
+}
+
+void bench_frame(bench_t* const b, const engine_t* const e, const float present_ms) {
+	const float cull = e->time_cull;
+	const float phases[PHASE_CNT] = {
+		e->time_edict, e->time_particle, cull, e->time_bones, e->time_verts, e->time_shadow, e->time_frag, present_ms,
+		e->time_edict+e->time_particle+cull+e->time_bones+e->time_verts+e->time_shadow+e->time_frag+present_ms,
+	};
+	const u64 hash = fb_hash(e->fb_real, SCREEN_W*SCREEN_H);
+	b->hash = (b->hash ^ hash) * 0x100000001b3ull;
+	for (size_t i=0; i<PHASE_CNT; i++)
+		b->totals[i] += phases[i];
+
+	if (b->out) {
+		if (b->json) {
+			fprintf(b->out, "%s{\"frame\":%u", b->frame ? ",\n" : "", b->frame);
+			for (size_t i=0; i<PHASE_CNT; i++)
+				fprintf(b->out, ",\"%s\":%.4f", PHASE_NAMES[i], phases[i]);
+			fprintf(b->out, ",\"hash\":\"%016llx\"}", (unsigned long long)hash);
+		} else {
+			fprintf(b->out, "%u", b->frame);
+			for (size_t i=0; i<PHASE_CNT; i++)
+				fprintf(b->out, ",%.4f", phases[i]);
+			fprintf(b->out, ",%016llx\n", (unsigned long long)hash);
+		}
+	}
+
+	b->frame++;
+	if (b->frames_max && b->frame >= b->frames_max)
+		b->done = 1;
+}
+
+void bench_finish(bench_t* const b) {
+	if (b->demo_out)
+		fclose(b->demo_out);
+	if (b->demo_in)
+		fclose(b->demo_in);
+	if (b->frame == 0) {
+		if (b->out)
+			fclose(b->out);
+		return;
+	}
+
+	if (b->out) {
+		if (b->json) {
+			fputs("\n],\"mean\":{", b->out);
+			for (size_t i=0; i<PHASE_CNT; i++)
+				fprintf(b->out, "%s\"%s\":%.4f", i ? "," : "", PHASE_NAMES[i], b->totals[i]/b->frame);
+			fprintf(b->out, "},\"hash\":\"%016llx\"}\n", (unsigned long long)b->hash);
+		}
+		fclose(b->out);
+	}
+
+	myprintf("[bench] frames:%u hash:%016llx\n", b->frame, (unsigned long long)b->hash);
+	char line[256];
+	size_t len = 0;
+	for (size_t i=0; i<PHASE_CNT; i++)
+		len += stbsp_snprintf(&line[len], sizeof(line)-len, " %s:%.3f", PHASE_NAMES[i], b->totals[i]/b->frame);
+	myprintf("[bench] mean ms%s\n", line);
+}
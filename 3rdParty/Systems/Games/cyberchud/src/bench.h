@@ -0,0 +1,47 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+
+#include "engine.h"
+#include "game.h"
+
+/* Demo file: header then one controls_t per tick, as input() left it */
+#define DEMO_MAGIC 0x4d444343 // "CCDM"
+#define DEMO_VERSION 1
+
+typedef struct {
+	u32 magic;
+	u32 version;
+	u32 controls_size;
+	i32 level; // -1 starts on the title
+} demo_header_t;
+
+#define BENCH_PHASE_CNT 9
+
+typedef struct {
+	FILE* demo_in;
+	FILE* demo_out;
+	FILE* out;
+	int json;
+	int done;
+	i32 level;
+	u32 frame;
+	u32 frames_max;
+	i32 particles;
+	i32 mobs;
+	int mobs_spawned;
+	u64 hash; // every frame's hash folded together
+	double totals[BENCH_PHASE_CNT];
+	rgba_t swiz[SCREEN_W*SCREEN_H];
+} bench_t;
+
+int bench_init(bench_t* const b, const init_cfg_t* const cfg);
+int bench_input(bench_t* const b, controls_t* const c);
+void bench_record(bench_t* const b, const controls_t* const c);
+void bench_tick(bench_t* const b, engine_t* const e);
+float bench_present(bench_t* const b, const engine_t* const e);
+void bench_frame(bench_t* const b, const engine_t* const e, const float present_ms);
+void bench_finish(bench_t* const b);
+
+#endif
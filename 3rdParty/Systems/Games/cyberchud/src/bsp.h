@@ -223,14 +223,6 @@ typedef struct {
 	bsp_dentry_t models;    // List of Models, nummodels = Size/sizeof(model_t)
 } bsp_header_t;
 
-typedef struct areanode_s {
-	int32_t axis; // -1 = leaf node
-	float dist;
-	struct areanode_s *children[2];
-	link_t trigger_edicts;
-	link_t solid_edicts;
-} areanode_t;
-
 typedef enum {
 	BSP_ENTITY_START,
 	BSP_ENTITY_MOB_CHUD,
@@ -310,6 +302,8 @@ typedef struct {
 
 	/* Non-File Data */
 	size_t malloc_size;
+	size_t model_size;
+	char* model_mem; // mesh faces, verts and uvs of every qmod
 	bsp_qmodel_t* qmods;
 	bsp_mleaf_t* leafs;
 	bsp_mnode_t* nodes;
@@ -348,6 +342,29 @@ typedef void (*edict_touch_t)(void *e, int32_t id, int32_t other);
 #define SOLID_SLIDEBOX 3 // touch on edge, but not an onground
 #define SOLID_BSP      4 // bsp clip, touch on edge, block
 
+/* Broadphase, a uniform grid over the world's x/z with a solid and a trigger list per cell.
+ * Edicts sit in the cell holding their center, boxes wider than a cell go in the last one which every query walks. */
+#define AREA_CELL_SIZE (128.0f/BSP_RESIZE_DIV)
+#define AREA_GRID_MAX 128 // per axis, cells grow past AREA_CELL_SIZE on bigger maps
+typedef struct {
+	vec4s min; // w is 0, the overlap test is one compare per side
+	vec4s max;
+} area_box_t;
+
+typedef struct {
+	area_box_t* boxes; // stb_ds, next to ents so a query scans them without touching the edicts
+	struct edict_s** ents;
+} area_list_t;
+
+typedef struct {
+	float origin_x;
+	float origin_z;
+	float cell_size;
+	int32_t w;
+	int32_t h;
+	area_list_t* lists; // (w*h+1)*2, solid then trigger for each cell, the last pair is for oversized boxes
+} area_grid_t;
+
 #define MAX_ENT_LEAFS 32
 typedef struct {
 	/* Link Data */
@@ -359,7 +376,7 @@ typedef struct {
 	int32_t leafnums[MAX_ENT_LEAFS];
 } edict_basic_t;
 
-typedef struct  {
+typedef struct edict_s {
 	edict_basic_t basic;
 	edict_touch_t touch;
 	edict_touch_t click;
@@ -371,6 +388,8 @@ typedef struct  {
 	int16_t solid;
 
 	const hull_t *hulls[MAX_MAP_HULLS];
+	area_list_t* area_list; // NULL while unlinked
+	int32_t area_idx;
 } edict_t;
 
 typedef struct {
@@ -378,15 +397,12 @@ typedef struct {
 	vec3s pos;
 } edict_light_t;
 
-#define MAX_AREA_DEPTH 9
-#define AREA_NODES (2 << MAX_AREA_DEPTH)
 typedef struct {
-	int32_t numareanodes;
 	int32_t map_id;
 	int32_t edict_cnt;
 	int32_t edict_light_cnt;
-	areanode_t areanodes[AREA_NODES];
-	alloc_t edict_mem;
+	area_grid_t area;
+	pool_t edict_mem; // edict_t and edict_light_t slots
 	i32 buf_cap;
 	edict_t** moved_edict_buf;
 	vec3s* moved_from_buf;
@@ -0,0 +1,417 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bsp_cook.h"
+#include "bsp_parse.h"
+#include "text.h"
+#include "utils/myds.h"
+#include "utils/mymalloc.h"
+#include "utils/pad.h"
+
+#ifdef BSP_COOK
+_Static_assert(sizeof(void*) == sizeof(u64), "cooked pointers are stored as 64 bit");
+
+#define COOK_SHIFT 48
+#define COOK_OFFSET_MASK ((1ull<<COOK_SHIFT)-1)
+
+/* where a cooked pointer points, 0 is NULL */
+enum {
+	COOK_BASE_NULL,
+	COOK_BASE_BLOCK,
+	COOK_BASE_MODEL,
+	COOK_BASE_BSP,
+	COOK_BASE_LUX,
+	COOK_BASE_CNT,
+};
+
+typedef void (*cook_slot_fn)(void* const ctx, void* const slot);
+
+typedef struct {
+	const char* src;
+	size_t size;
+	char* dst;
+} cook_src_t;
+
+typedef struct {
+	const char* base[COOK_BASE_CNT];
+	size_t size[COOK_BASE_CNT];
+	cook_src_t* srcs; // original memory and where its copy sits in the file
+	int err;
+} cook_write_t;
+
+typedef struct {
+	char* base[COOK_BASE_CNT];
+} cook_read_t;
+
+static u32 fnv1a(u32 hash, const void* const data, const size_t len) {
+	const u8* const bytes = data;
+	for (size_t i=0; i<len; i++) {
+		hash ^= bytes[i];
+		hash *= 0x01000193;
+	}
+	return hash;
+}
+
+static u32 cook_layout(void) {
+	const u32 sizes[] = {
+		sizeof(bsp_qmodel_t), sizeof(bsp_mleaf_t), sizeof(bsp_msurface_t), sizeof(bsp_mnode_t),
+		sizeof(bsp_clipnode_t), sizeof(bsp_texture_t), sizeof(bsp_face_lookup_t), sizeof(mesh_t),
+		sizeof(face_t), sizeof(bsp_litinfo_t), sizeof(vert_tangent_t), sizeof(bsp_entity_t),
+	};
+	return fnv1a(0x811c9dc5, sizes, sizeof(sizes));
+}
+
+u32 bsp_cook_hash(const char* const start, const size_t bsp_size, const bsp_lux_t* const lux, const size_t lux_size) {
+	const u64 sizes[2] = {bsp_size, lux_size};
+	const u32 hash = fnv1a(0x811c9dc5, sizes, sizeof(sizes));
+	return fnv1a(fnv1a(hash, start, bsp_size), lux, lux_size);
+}
+
+/* names, px indices and shaders, the cooked meshes bake all of them in */
+static u32 cook_material_hash(void) {
+	u32 cnt;
+	const material_info_t* const mats = bsp_materials(&cnt);
+	u32 hash = fnv1a(0x811c9dc5, &cnt, sizeof(cnt));
+	for (u32 i=0; i<cnt; i++) {
+		const i16 info[3] = {mats[i].normal, mats[i].shader_idx, mats[i].diff_cnt};
+		hash = fnv1a(hash, mats[i].name, strlen(mats[i].name)+1);
+		hash = fnv1a(hash, info, sizeof(info));
+		hash = fnv1a(hash, mats[i].diffuse, mats[i].diff_cnt*sizeof(i16));
+	}
+	return hash;
+}
+
+static size_t cook_data_size(const bsp_cook_header_t* const header) {
+	return pad_inc_count(header->block_size, 64)
+		+ pad_inc_count(header->model_size, 64)
+		+ pad_inc_count(header->mesh_cnt*sizeof(mesh_t), 64)
+		+ pad_inc_count(header->diffuse_cnt*sizeof(i16), 64)
+		+ pad_inc_count(header->entity_cnt*sizeof(bsp_entity_t), 64);
+}
+
+/* Every pointer in the engine block and in the meshes.
+ * qmod->model.meshes and the mesh textures live in balloc memory, the caller deals with those. */
+static void cook_walk(const bsp_t* const bsp, cook_slot_fn fn, void* const ctx) {
+	for (u32 i=0; i<bsp->model_cnt; i++) {
+		bsp_qmodel_t* const qmod = &bsp->qmods[i];
+		for (int j=0; j<MAX_MAP_HULLS; j++) {
+			fn(ctx, &qmod->hulls[j].clipnodes);
+			fn(ctx, &qmod->hulls[j].planes);
+		}
+		fn(ctx, &qmod->nodes);
+		fn(ctx, &qmod->leafs);
+		fn(ctx, &qmod->lightdata);
+		fn(ctx, &qmod->face_lookup);
+		fn(ctx, &qmod->miptex_to_mesh_lookup);
+		fn(ctx, &qmod->textures);
+		for (u32 j=0; j<qmod->model.mesh_cnt; j++) {
+			mesh_t* const mesh = &qmod->model.meshes[j];
+			fn(ctx, &mesh->faces);
+			fn(ctx, &mesh->verts);
+			fn(ctx, &mesh->uv);
+			fn(ctx, &mesh->uv_lightmap);
+			fn(ctx, &mesh->weights);
+			fn(ctx, &mesh->litdata);
+			bsp_litinfo_t* const litdata = (bsp_litinfo_t*)mesh->litdata;
+			for (u32 f=0; f<mesh->face_cnt; f++) {
+				fn(ctx, &litdata[f].lightmap);
+				fn(ctx, &litdata[f].luxmap);
+			}
+		}
+	}
+
+	for (u32 i=0; i<bsp->leaf_cnt; i++) {
+		bsp_mleaf_t* const leaf = &bsp->leafs[i];
+		fn(ctx, &leaf->compressed_vis);
+		fn(ctx, &leaf->firstmarksurface);
+	}
+
+	for (u32 i=0; i<bsp->face_cnt; i++) {
+		bsp_msurface_t* const surf = &bsp->msurfs[i];
+		fn(ctx, &surf->plane);
+		fn(ctx, &surf->samples);
+		fn(ctx, &surf->luxmap);
+		fn(ctx, &surf->texinfo);
+	}
+
+	for (u32 i=0; i<bsp->node_cnt; i++) {
+		bsp_mnode_t* const node = &bsp->nodes[i];
+		fn(ctx, &node->plane);
+		fn(ctx, &node->children[0]);
+		fn(ctx, &node->children[1]);
+	}
+}
+
+static int cook_find_base(const cook_write_t* const w, const char* const ptr) {
+	for (int i=1; i<COOK_BASE_CNT; i++) {
+		if (ptr >= w->base[i] && ptr < w->base[i]+w->size[i])
+			return i;
+	}
+	/* one past the end, e.g. firstmarksurface of an empty leaf */
+	for (int i=1; i<COOK_BASE_CNT; i++) {
+		if (ptr == w->base[i]+w->size[i])
+			return i;
+	}
+	return -1;
+}
+
+static void cook_encode(void* const ctx, void* const slot) {
+	cook_write_t* const w = ctx;
+	const char* ptr;
+	memcpy(&ptr, slot, sizeof(ptr));
+	u64 val = 0;
+	if (ptr) {
+		const int base = cook_find_base(w, ptr);
+		if (base < 0) {
+			myprintf("[ERR] [bsp_cook_write] pointer 0x%p outside the level\n", ptr);
+			w->err = 1;
+			return;
+		}
+		val = (u64)base<<COOK_SHIFT | (u64)(ptr-w->base[base]);
+	}
+
+	for (i32 i=0; i<myarrlen(w->srcs); i++) {
+		const cook_src_t* const src = &w->srcs[i];
+		if ((const char*)slot >= src->src && (const char*)slot < src->src+src->size) {
+			memcpy(src->dst + ((const char*)slot-src->src), &val, sizeof(val));
+			return;
+		}
+	}
+	assert(0);
+	w->err = 1;
+}
+
+static void cook_decode(void* const ctx, void* const slot) {
+	const cook_read_t* const r = ctx;
+	u64 val;
+	memcpy(&val, slot, sizeof(val));
+	char* const ptr = val ? r->base[val>>COOK_SHIFT] + (val&COOK_OFFSET_MASK) : NULL;
+	memcpy(slot, &ptr, sizeof(ptr));
+}
+
+static int px_idx(const px_t* const* const px, const int cnt, const px_t* const find) {
+	for (int i=0; i<cnt; i++) {
+		if (px[i] == find)
+			return i;
+	}
+	return -1;
+}
+
+int bsp_cook_write(const char* const path, const u32 bsp_hash, const bsp_t* const bsp, const char* const start, const size_t bsp_size, const bsp_lux_t* const lux, const size_t lux_size, const assets_t* const assets) {
+	bsp_cook_header_t header = {
+		.magic = BSP_COOK_MAGIC,
+		.version = BSP_COOK_VERSION,
+		.layout = cook_layout(),
+		.bsp_hash = bsp_hash,
+		.material_hash = cook_material_hash(),
+		.px_gray_cnt = PX_GRAY_TOTAL,
+		.px_rgb_cnt = PX_RGB_TOTAL,
+		.block_size = bsp->malloc_size,
+		.model_size = bsp->model_size,
+		.entity_cnt = myarrlen(bsp->entities),
+	};
+	for (u32 i=0; i<bsp->model_cnt; i++) {
+		const model_basic_t* const model = &bsp->qmods[i].model;
+		header.mesh_cnt += model->mesh_cnt;
+		for (u32 j=0; j<model->mesh_cnt; j++)
+			header.diffuse_cnt += model->meshes[j].tex_diffuse_cnt;
+	}
+
+	const size_t data_size = cook_data_size(&header);
+	char* const data = aligned_alloc(64, data_size);
+	if (data == NULL) {
+		myprintf("[ERR] [bsp_cook_write] can't alloc %zu\n", data_size);
+		return 1;
+	}
+	memset(data, 0, data_size);
+	char* writer = data;
+	char* const block = pad_inc_ptr(&writer, header.block_size, 64);
+	char* const models = pad_inc_ptr(&writer, header.model_size, 64);
+	mesh_t* meshes = pad_inc_ptr(&writer, header.mesh_cnt*sizeof(mesh_t), 64);
+	i16* const diffuse = pad_inc_ptr(&writer, header.diffuse_cnt*sizeof(i16), 64);
+	bsp_entity_t* const entities = pad_inc_ptr(&writer, header.entity_cnt*sizeof(bsp_entity_t), 64);
+	memcpy(block, bsp->qmods, header.block_size);
+	memcpy(models, bsp->model_mem, header.model_size);
+	memcpy(entities, bsp->entities, header.entity_cnt*sizeof(bsp_entity_t));
+
+	cook_write_t w = {0};
+	w.base[COOK_BASE_BLOCK] = (const char*)bsp->qmods;
+	w.size[COOK_BASE_BLOCK] = header.block_size;
+	w.base[COOK_BASE_MODEL] = bsp->model_mem;
+	w.size[COOK_BASE_MODEL] = header.model_size;
+	w.base[COOK_BASE_BSP] = start;
+	w.size[COOK_BASE_BSP] = bsp_size;
+	w.base[COOK_BASE_LUX] = (const char*)lux;
+	w.size[COOK_BASE_LUX] = lux_size;
+	arrput(w.srcs, ((cook_src_t){(const char*)bsp->qmods, header.block_size, block}));
+	arrput(w.srcs, ((cook_src_t){bsp->model_mem, header.model_size, models}));
+
+	/* meshes back to back, textures become px indices */
+	u32 diffuse_pos = 0;
+	for (u32 i=0; i<bsp->model_cnt; i++) {
+		const model_basic_t* const model = &bsp->qmods[i].model;
+		((bsp_qmodel_t*)block)[i].model.meshes = NULL;
+		if (model->mesh_cnt == 0)
+			continue;
+		arrput(w.srcs, ((cook_src_t){(const char*)model->meshes, model->mesh_cnt*sizeof(mesh_t), (char*)meshes}));
+		for (u32 j=0; j<model->mesh_cnt; j++, meshes++) {
+			const mesh_t* const mesh = &model->meshes[j];
+			*meshes = *mesh;
+			meshes->tex_diffuse = (const px_t**)(uintptr_t)diffuse_pos;
+			for (i8 d=0; d<mesh->tex_diffuse_cnt; d++) {
+				const int idx = px_idx(assets->px_gray, PX_GRAY_TOTAL, mesh->tex_diffuse[d]);
+				w.err |= idx < 0;
+				diffuse[diffuse_pos++] = idx;
+			}
+			const int normal = mesh->tex_normal ? px_idx(assets->px_rgb, PX_RGB_TOTAL, mesh->tex_normal) : -1;
+			w.err |= mesh->tex_normal && normal < 0;
+			meshes->tex_normal = (const px_t*)(uintptr_t)(normal+1);
+		}
+	}
+
+	cook_walk(bsp, cook_encode, &w);
+	arrfree(w.srcs);
+
+	FILE* const fp = w.err ? NULL : fopen(path, "wb");
+	const int err = fp == NULL
+		|| fwrite(&header, sizeof(header), 1, fp) != 1
+		|| fwrite(data, 1, data_size, fp) != data_size;
+	if (fp)
+		fclose(fp);
+	free(data);
+	if (err) {
+		myprintf("[ERR] [bsp_cook_write] %s\n", path);
+		return 1;
+	}
+	myprintf("[bsp_cook_write] %s meshes:%u entities:%u size:%zu\n", path, header.mesh_cnt, header.entity_cnt, sizeof(header)+data_size);
+	return 0;
+}
+
+/* Undoes a partial bsp_cook_load so bsp_parse starts from a clean bsp_t */
+static void cook_load_free(bsp_t* const bsp, alloc_t* const alloc) {
+	if (bsp->qmods == NULL)
+		return;
+	for (u32 i=0; i<bsp->model_cnt; i++) {
+		model_basic_t* const model = &bsp->qmods[i].model;
+		if (model->meshes == NULL)
+			continue;
+		for (u32 j=0; j<model->mesh_cnt; j++) {
+			if (model->meshes[j].tex_diffuse)
+				bfree(alloc, model->meshes[j].tex_diffuse);
+		}
+		bfree(alloc, model->meshes);
+		model->meshes = NULL;
+	}
+	if (bsp->model_mem)
+		myfree(bsp->model_mem);
+	myfree(bsp->qmods);
+	bsp->model_mem = NULL;
+	bsp->qmods = NULL;
+}
+
+int bsp_cook_load(const char* const path, const u32 bsp_hash, char* const start, const size_t bsp_size, const bsp_lux_t* const lux, const size_t lux_size, bsp_t* const bsp, const assets_t* const assets, alloc_t* const alloc) {
+	FILE* const fp = fopen(path, "rb");
+	if (fp == NULL)
+		return 1;
+	bsp_cook_header_t header;
+	if (fread(&header, sizeof(header), 1, fp) != 1 || header.magic != BSP_COOK_MAGIC
+	|| header.version != BSP_COOK_VERSION || header.layout != cook_layout()
+	|| header.bsp_hash != bsp_hash || header.material_hash != cook_material_hash()
+	|| header.px_gray_cnt != PX_GRAY_TOTAL || header.px_rgb_cnt != PX_RGB_TOTAL) {
+		myprintf("[bsp_cook_load] %s is stale, parsing the BSP instead\n", path);
+		fclose(fp);
+		return 1;
+	}
+	const size_t data_size = cook_data_size(&header);
+	char* const data = aligned_alloc(64, data_size);
+	const int read_err = data == NULL || fread(data, 1, data_size, fp) != data_size;
+	fclose(fp);
+	if (read_err) {
+		myprintf("[ERR] [bsp_cook_load] can't read %s\n", path);
+		free(data);
+		return 1;
+	}
+
+	/* the lump pointers are cheap, the engine block has to match what bsp_alloc carves for these counts */
+	bsp_parse_header(start, bsp);
+	if (bsp_alloc(bsp) || bsp->malloc_size != header.block_size) {
+		myprintf("[ERR] [bsp_cook_load] %s block size mismatch\n", path);
+		cook_load_free(bsp, alloc);
+		free(data);
+		return 1;
+	}
+	char* reader = data;
+	const char* const block = pad_inc_ptr(&reader, header.block_size, 64);
+	const char* const models = pad_inc_ptr(&reader, header.model_size, 64);
+	const mesh_t* meshes = pad_inc_ptr(&reader, header.mesh_cnt*sizeof(mesh_t), 64);
+	const i16* const diffuse = pad_inc_ptr(&reader, header.diffuse_cnt*sizeof(i16), 64);
+	const bsp_entity_t* const entities = pad_inc_ptr(&reader, header.entity_cnt*sizeof(bsp_entity_t), 64);
+	memcpy(bsp->qmods, block, header.block_size);
+	bsp->model_size = header.model_size;
+	bsp->model_mem = mymalloc(header.model_size);
+	if (bsp->model_mem == NULL) {
+		myprintf("[ERR] [bsp_cook_load] can't alloc %u\n", header.model_size);
+		cook_load_free(bsp, alloc);
+		free(data);
+		return 1;
+	}
+	memcpy(bsp->model_mem, models, header.model_size);
+
+	/* meshes and their textures go to the buddy allocator, same as bsp_extract_textures */
+	for (u32 i=0; i<bsp->model_cnt; i++) {
+		model_basic_t* const model = &bsp->qmods[i].model;
+		if (model->mesh_cnt == 0)
+			continue;
+		model->meshes = balloc(alloc, sizeof(mesh_t)*model->mesh_cnt);
+		if (model->meshes == NULL) {
+			myprintf("[ERR] [bsp_cook_load] can't alloc\n");
+			cook_load_free(bsp, alloc);
+			free(data);
+			return 1;
+		}
+		/* the cooked tex_diffuse is an index, nothing for cook_load_free until it's resolved */
+		memcpy(model->meshes, meshes, sizeof(mesh_t)*model->mesh_cnt);
+		for (u32 j=0; j<model->mesh_cnt; j++)
+			model->meshes[j].tex_diffuse = NULL;
+		for (u32 j=0; j<model->mesh_cnt; j++) {
+			mesh_t* const mesh = &model->meshes[j];
+			const i16* const diffuse_idx = &diffuse[(uintptr_t)meshes[j].tex_diffuse];
+			const px_t** const tex_diffuse = balloc(alloc, sizeof(px_t*)*mesh->tex_diffuse_cnt);
+			if (tex_diffuse == NULL) {
+				myprintf("[ERR] [bsp_cook_load] can't alloc\n");
+				cook_load_free(bsp, alloc);
+				free(data);
+				return 1;
+			}
+			for (i8 d=0; d<mesh->tex_diffuse_cnt; d++)
+				tex_diffuse[d] = assets->px_gray[diffuse_idx[d]];
+			mesh->tex_diffuse = tex_diffuse;
+			const uintptr_t normal = (uintptr_t)mesh->tex_normal;
+			mesh->tex_normal = normal ? assets->px_rgb[normal-1] : NULL;
+		}
+		meshes += model->mesh_cnt;
+	}
+
+	/* pointer fix-up */
+	cook_read_t r;
+	r.base[COOK_BASE_NULL] = NULL;
+	r.base[COOK_BASE_BLOCK] = (char*)bsp->qmods;
+	r.base[COOK_BASE_MODEL] = bsp->model_mem;
+	r.base[COOK_BASE_BSP] = start;
+	r.base[COOK_BASE_LUX] = (char*)lux;
+	cook_walk(bsp, cook_decode, &r);
+	for (u32 i=0; i<bsp->leaf_cnt; i++) {
+		bsp->leafs[i].lights = (link_t){0};
+		bsp->leafs[i].lights_dynamic = (link_t){0};
+	}
+
+	arrsetcap(bsp->entities, header.entity_cnt+1);
+	arrsetlen(bsp->entities, header.entity_cnt);
+	memcpy(bsp->entities, entities, header.entity_cnt*sizeof(bsp_entity_t));
+
+	free(data);
+	return 0;
+}
+#endif
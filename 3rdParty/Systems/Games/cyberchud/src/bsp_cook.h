@@ -0,0 +1,36 @@
+#ifndef BSP_COOK_H
+#define BSP_COOK_H
+
+#include "assets.h"
+
+/* Precooked level: bsp_parse's output dumped as is, pointers stored as (base << 48 | offset).
+ * The file sits next to data.wad and is only used if it was cooked from the same lumps and materials,
+ * bsp_cook_hash runs over the raw lumps before bsp_transform and bsp_luxmap_fix patch them. */
+#define BSP_COOK_MAGIC 0x4b4f4f43 // "COOK"
+#define BSP_COOK_VERSION 2
+#define BSP_COOK_PATH "level%02d.cook"
+
+#if !defined(__EMSCRIPTEN__)
+#define BSP_COOK 1
+#endif
+
+typedef struct {
+	u32 magic;
+	u32 version;
+	u32 layout; // struct sizes folded together
+	u32 bsp_hash; // bsp_cook_hash
+	u32 material_hash; // bsp_materials
+	u32 px_gray_cnt;
+	u32 px_rgb_cnt;
+	u32 block_size; // bsp_alloc
+	u32 model_size; // bsp_alloc_models
+	u32 mesh_cnt;
+	u32 diffuse_cnt;
+	u32 entity_cnt;
+} bsp_cook_header_t;
+
+u32 bsp_cook_hash(const char* const start, const size_t bsp_size, const bsp_lux_t* const lux, const size_t lux_size);
+int bsp_cook_write(const char* const path, const u32 bsp_hash, const bsp_t* const bsp, const char* const start, const size_t bsp_size, const bsp_lux_t* const lux, const size_t lux_size, const assets_t* const assets);
+int bsp_cook_load(const char* const path, const u32 bsp_hash, char* const start, const size_t bsp_size, const bsp_lux_t* const lux, const size_t lux_size, bsp_t* const bsp, const assets_t* const assets, alloc_t* const alloc);
+
+#endif
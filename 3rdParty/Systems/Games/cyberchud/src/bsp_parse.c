@@ -452,54 +452,59 @@ static const i16 WAVES0_TEX_DIFF[] = {PX_GRAY_TEX_WAVES0};
 static const i16 WIRES0_TEX_DIFF[] = {PX_GRAY_TEX_WIRES0};
 static const i16 WOOD066_TEX_DIFF[] = {PX_GRAY_TEX_WOOD066};
 
-static const material_info_t* lookup_material(const char* const material) {
-	static const material_info_t MATERIAL_DATA[MATERIAL_TOTAL] = {
-		{"ANIMUTV", ANIMU_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 4},
-		{"BOOKS0", BOOKS0_TEX_DIFF, PX_RGB_NMAP_BOOKS0, 0, 1},
-		{"BRICKS", BRICKS_TEX_DIFF, PX_RGB_NMAP_BRICKS, 0, 1},
-		{"BR_WALL0", BR_WALL0_TEX_DIFF, PX_RGB_NMAP_BR_WALL0, 0, 1},
-		{"CHECKERFLOOR", CHECKERFLOOR_TEX_DIFF, PX_RGB_NMAP_CHECKERFLOOR, 0, 1},
-		{"CLOCK0", CLOCK0_TEX_DIFF, PX_RGB_NMAP_CLOCK0, 0, 1},
-		{"CONSOLE0", CONSOLE0_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 6},
-		{"DOOR0", DOOR0_TEX_DIFF, PX_RGB_NMAP_DOOR0, 0, 1},
-		{"DOOR1", DOOR1_TEX_DIFF, PX_RGB_NMAP_DOOR1, 0, 1},
-		{"DPLATE006C", DPLATE006C_TEX_DIFF, PX_RGB_NMAP_DPLATE006C, 0, 1},
-		{"ERROR0", ERROR0_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 16},
-		{"FABRIC0020", FABRIC0020_TEX_DIFF, PX_RGB_NMAP_FABRIC0020, 0, 1},
-		{"FABRIC025", FABRIC025_TEX_DIFF, PX_RGB_NMAP_FABRIC025, 0, 1},
-		{"KEYBOARD", KEYBOARD_TEX_DIFF, PX_RGB_NMAP_KEYBOARD, 0, 1},
-		{"LAIN0", LAIN0_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 6},
-		{"LITME0", LITME0_TEX_DIFF, PX_RGB_NMAP_DEFAULT, 0, 1},
-		{"LIGHT0", LIGHT0_TEX_DIFF, PX_RGB_NMAP_LIGHT0, 1, 1},
-		{"METAL0076", METAL0076_TEX_DIFF, PX_RGB_NMAP_METAL0076, 0, 1},
-		{"METAL0068", METAL0068_TEX_DIFF, PX_RGB_NMAP_METAL0068, 0, 1},
-		{"METAL022", METAL022_TEX_DIFF, PX_RGB_NMAP_METAL022, 0, 1},
-		{"METALPLATE0", METALPLATE0_TEX_DIFF, PX_RGB_NMAP_METALPLATE0, 0, 1},
-		{"METALPLATES001", METALPLATES001_TEX_DIFF, PX_RGB_NMAP_METALPLATES001, 0, 1},
-		{"METALPLATES009", METALPLATES009_TEX_DIFF, PX_RGB_NMAP_METALPLATES009, 0, 1},
-		{"MONITOR0", MONITOR0_TEX_DIFF, PX_RGB_NMAP_MONITOR0, 0, 1},
-		{"NAMEPLATE0", NAMEPLATE0_TEX_DIFF, PX_RGB_NMAP_NAMEPLATE0, 0, 1},
-		{"NOSLEEP", NOSLEEP_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 10},
-		{"PAINTMETAL005", PAINTMETAL005_TEX_DIFF, PX_RGB_NMAP_PAINTMETAL005, 0, 1},
-		{"PANEL0", PANEL0_TEX_DIFF, PX_RGB_NMAP_PANEL0, 0, 1},
-		{"PAVINGSTONE128", PAVINGSTONE128_TEX_DIFF, PX_RGB_NMAP_PAVINGSTONE128, 0, 1},
-		{"PIXELMUTT", PIXELMUTT_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 21},
-		{"PLASTIC0018", PLASTIC0018_TEX_DIFF, PX_RGB_NMAP_PLASTIC0018, 0, 1},
-		{"RACK_FRONT", RACK_FRONT_TEX_DIFF, PX_RGB_NMAP_RACK_FRONT, 0, 1},
-		{"SCIFI0", SCIFI0_TEX_DIFF, PX_RGB_NMAP_SCIFI0, 0, 1},
-		{"SCRATCH0", SCRATCH0_TEX_DIFF, PX_RGB_NMAP_SCRATCH0, 0, 1},
-		{"SCUM_WIGGLER", SCUM_WIGGLER_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 5},
-		{"SOY0", SOY0_TEX_DIFF, PX_RGB_NMAP_SOY0, 0, 1},
-		{"TACTILE003", TACTILE003_TEX_DIFF, PX_RGB_NMAP_TACTILE003, 0, 1},
-		{"TILES0094", TILES0094_TEX_DIFF, PX_RGB_NMAP_TILES0094, 0, 1},
-		{"TRASHBIN0_FR", TRASHBIN0_FR_TEX_DIFF, PX_RGB_NMAP_TRASHBIN0_FR, 0, 1},
-		{"TRASHBIN0_SIDE", TRASHBIN0_SIDE_TEX_DIFF, PX_RGB_NMAP_TRASHBIN0_SIDE, 0, 1},
-		{"TRIPPY0", TRIPPY0_TEX_DIFF, PX_RGB_NMAP_TRIPPY0, 0, 1},
-		{"WAVES0", WAVES0_TEX_DIFF, PX_RGB_NMAP_WAVES0, 0, 1},
-		{"WIRES0", WIRES0_TEX_DIFF, PX_RGB_NMAP_WIRES0, 0, 1},
-		{"WOOD066", WOOD066_TEX_DIFF, PX_RGB_NMAP_WOOD066, 0, 1},
-	};
+static const material_info_t MATERIAL_DATA[MATERIAL_TOTAL] = {
+	{"ANIMUTV", ANIMU_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 4},
+	{"BOOKS0", BOOKS0_TEX_DIFF, PX_RGB_NMAP_BOOKS0, 0, 1},
+	{"BRICKS", BRICKS_TEX_DIFF, PX_RGB_NMAP_BRICKS, 0, 1},
+	{"BR_WALL0", BR_WALL0_TEX_DIFF, PX_RGB_NMAP_BR_WALL0, 0, 1},
+	{"CHECKERFLOOR", CHECKERFLOOR_TEX_DIFF, PX_RGB_NMAP_CHECKERFLOOR, 0, 1},
+	{"CLOCK0", CLOCK0_TEX_DIFF, PX_RGB_NMAP_CLOCK0, 0, 1},
+	{"CONSOLE0", CONSOLE0_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 6},
+	{"DOOR0", DOOR0_TEX_DIFF, PX_RGB_NMAP_DOOR0, 0, 1},
+	{"DOOR1", DOOR1_TEX_DIFF, PX_RGB_NMAP_DOOR1, 0, 1},
+	{"DPLATE006C", DPLATE006C_TEX_DIFF, PX_RGB_NMAP_DPLATE006C, 0, 1},
+	{"ERROR0", ERROR0_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 16},
+	{"FABRIC0020", FABRIC0020_TEX_DIFF, PX_RGB_NMAP_FABRIC0020, 0, 1},
+	{"FABRIC025", FABRIC025_TEX_DIFF, PX_RGB_NMAP_FABRIC025, 0, 1},
+	{"KEYBOARD", KEYBOARD_TEX_DIFF, PX_RGB_NMAP_KEYBOARD, 0, 1},
+	{"LAIN0", LAIN0_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 6},
+	{"LITME0", LITME0_TEX_DIFF, PX_RGB_NMAP_DEFAULT, 0, 1},
+	{"LIGHT0", LIGHT0_TEX_DIFF, PX_RGB_NMAP_LIGHT0, 1, 1},
+	{"METAL0076", METAL0076_TEX_DIFF, PX_RGB_NMAP_METAL0076, 0, 1},
+	{"METAL0068", METAL0068_TEX_DIFF, PX_RGB_NMAP_METAL0068, 0, 1},
+	{"METAL022", METAL022_TEX_DIFF, PX_RGB_NMAP_METAL022, 0, 1},
+	{"METALPLATE0", METALPLATE0_TEX_DIFF, PX_RGB_NMAP_METALPLATE0, 0, 1},
+	{"METALPLATES001", METALPLATES001_TEX_DIFF, PX_RGB_NMAP_METALPLATES001, 0, 1},
+	{"METALPLATES009", METALPLATES009_TEX_DIFF, PX_RGB_NMAP_METALPLATES009, 0, 1},
+	{"MONITOR0", MONITOR0_TEX_DIFF, PX_RGB_NMAP_MONITOR0, 0, 1},
+	{"NAMEPLATE0", NAMEPLATE0_TEX_DIFF, PX_RGB_NMAP_NAMEPLATE0, 0, 1},
+	{"NOSLEEP", NOSLEEP_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 10},
+	{"PAINTMETAL005", PAINTMETAL005_TEX_DIFF, PX_RGB_NMAP_PAINTMETAL005, 0, 1},
+	{"PANEL0", PANEL0_TEX_DIFF, PX_RGB_NMAP_PANEL0, 0, 1},
+	{"PAVINGSTONE128", PAVINGSTONE128_TEX_DIFF, PX_RGB_NMAP_PAVINGSTONE128, 0, 1},
+	{"PIXELMUTT", PIXELMUTT_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 21},
+	{"PLASTIC0018", PLASTIC0018_TEX_DIFF, PX_RGB_NMAP_PLASTIC0018, 0, 1},
+	{"RACK_FRONT", RACK_FRONT_TEX_DIFF, PX_RGB_NMAP_RACK_FRONT, 0, 1},
+	{"SCIFI0", SCIFI0_TEX_DIFF, PX_RGB_NMAP_SCIFI0, 0, 1},
+	{"SCRATCH0", SCRATCH0_TEX_DIFF, PX_RGB_NMAP_SCRATCH0, 0, 1},
+	{"SCUM_WIGGLER", SCUM_WIGGLER_TEX_DIFF, PX_RGB_NMAP_CRT, 0, 5},
+	{"SOY0", SOY0_TEX_DIFF, PX_RGB_NMAP_SOY0, 0, 1},
+	{"TACTILE003", TACTILE003_TEX_DIFF, PX_RGB_NMAP_TACTILE003, 0, 1},
+	{"TILES0094", TILES0094_TEX_DIFF, PX_RGB_NMAP_TILES0094, 0, 1},
+	{"TRASHBIN0_FR", TRASHBIN0_FR_TEX_DIFF, PX_RGB_NMAP_TRASHBIN0_FR, 0, 1},
+	{"TRASHBIN0_SIDE", TRASHBIN0_SIDE_TEX_DIFF, PX_RGB_NMAP_TRASHBIN0_SIDE, 0, 1},
+	{"TRIPPY0", TRIPPY0_TEX_DIFF, PX_RGB_NMAP_TRIPPY0, 0, 1},
+	{"WAVES0", WAVES0_TEX_DIFF, PX_RGB_NMAP_WAVES0, 0, 1},
+	{"WIRES0", WIRES0_TEX_DIFF, PX_RGB_NMAP_WIRES0, 0, 1},
+	{"WOOD066", WOOD066_TEX_DIFF, PX_RGB_NMAP_WOOD066, 0, 1},
+};
+
+const material_info_t* bsp_materials(u32* const cnt) {
+	*cnt = MATERIAL_TOTAL;
+	return MATERIAL_DATA;
+}
 
+static const material_info_t* lookup_material(const char* const material) {
 	for (uint32_t i=0; i<MATERIAL_TOTAL; i++) {
 		if (strcmp(material, MATERIAL_DATA[i].name) == 0) {
 			return &MATERIAL_DATA[i];
@@ -720,7 +725,7 @@ static void bsp_parse_qmods(bsp_t* const bsp) {
 	}
 }
 
-static int bsp_alloc(bsp_t* const bsp) {
+int bsp_alloc(bsp_t* const bsp) {
 #ifndef NDEBUG
 	fputs("[bsp_alloc]\n", stdout);
 #endif
@@ -780,7 +785,7 @@ static int bsp_alloc(bsp_t* const bsp) {
 	return 0;
 }
 
-static void bsp_parse_header(char* const start, bsp_t* const bsp) {
+void bsp_parse_header(char* const start, bsp_t* const bsp) {
 	memset(bsp, 0, sizeof(bsp_t));
 	const bsp_header_t* const data = (const bsp_header_t* const)start;
 
@@ -823,9 +828,6 @@ static void bsp_parse_header(char* const start, bsp_t* const bsp) {
 	bsp->clipnodes = (bsp_clipnode_t*)(start+data->clipnodes.offset);
 	bsp->dmodels = (bsp_dmodel_t*)(start+data->models.offset);
 	bsp->lightdata = (const u8*)(start+data->lightmaps.offset);
-
-	/* Read Entities */
-	bsp_parse_entities(bsp, (const char*)(start+data->entities.offset));
 #ifndef NDEBUG
 	myprintf("[BSP] [cnt] vert:%u plane:%u node:%u clipnode:%u leaf:%u face:%u edge:%u lface:%u surfedge:%u texinfo:%u model:%u visdata:%u\n", bsp->vert_cnt, bsp->plane_cnt, bsp->node_cnt, bsp->clipnode_cnt, bsp->leaf_cnt, bsp->face_cnt, bsp->edge_cnt, bsp->lface_cnt, bsp->surfedge_cnt, bsp->texinfo_cnt, bsp->model_cnt, bsp->visdata_cnt);
 #endif
@@ -969,6 +971,9 @@ static int bsp_alloc_models(bsp_t* const bsp) {
 		return 1;
 	}
 
+	bsp->model_mem = model_ptr;
+	bsp->model_size = model_size;
+
 	/* Setup Malloc */
 	for (u32 i=0; i<bsp->model_cnt; i++) {
 		model_basic_t* const model = &bsp->qmods[i].model;
@@ -987,6 +992,67 @@ static int bsp_alloc_models(bsp_t* const bsp) {
 	return 0;
 }
 
+/* Flips the lux red channel on some faces, patches the lux lump in place so it may only run once per level */
+void bsp_luxmap_fix(const bsp_t* const bsp) {
+	for (u32 qi=0; qi<bsp->model_cnt; qi++) {
+		const bsp_qmodel_t* const qmod = &bsp->qmods[qi];
+		const int face_end = qmod->firstmodelsurface+qmod->nummodelsurfaces;
+		/* this is a big fucky wucky mess because I honestly am not fucking sure */
+		for (int i=qmod->firstmodelsurface; i<face_end; i++) {
+			const bsp_face_t* const face = &bsp->faces[i];
+			if (face->lightmap < 0)
+				continue;
+			const bsp_dtexinfo_t* const texinfo = &bsp->texinfo[face->texinfo_id];
+			const bsp_msurface_t* const surf = &bsp->msurfs[i];
+
+#if 0
+			if (texinfo->vectorS.x <= 0)
+				continue;
+			if (texinfo->vectorS.y != 0)
+				continue;
+			if (texinfo->vectorS.z != 0)
+				continue;
+			if (texinfo->distS != 0)
+				continue;
+
+			if (texinfo->vectorT.x != 0)
+				continue;
+			if (texinfo->vectorT.y >= 0)
+				continue;
+			if (texinfo->vectorT.z != 0)
+				continue;
+			if (texinfo->distT != 0)
+				continue;
+
+			if (surf->plane->normal.z >= 0)
+				continue;
+			if (surf->texturemins[1] >= 0)
+				continue;
+
+			print_vec3("vecS", texinfo->vectorS);
+			print_vec3("vecT", texinfo->vectorT);
+			myprintf("norm: %.2fx%.2fx%.2f\n", surf->plane->normal.x, surf->plane->normal.y, surf->plane->normal.z);
+			myprintf("texmins %d %d pdist:%.2f\n", surf->texturemins[0], surf->texturemins[1], surf->plane->dist);
+#endif
+
+			const float dots = glm_vec3_dot(surf->plane->normal.raw, texinfo->vectorS.raw) + surf->plane->dist;
+			const float dott = glm_vec3_dot(surf->plane->normal.raw, texinfo->vectorT.raw) + surf->plane->dist;
+			/* const float dots = glm_vec3_dot(surf->plane->normal.raw, texinfo->vectorS.raw) + texinfo->distS + surf->plane->dist; */
+			/* const float dott = glm_vec3_dot(surf->plane->normal.raw, texinfo->vectorT.raw) + texinfo->distT + surf->plane->dist; */
+			if (dots >= 0 || dott >= 0)
+				continue;
+
+			const int w = (surf->extents[0]>>4)+1;
+			const int h = (surf->extents[1]>>4)+1;
+			for (int j=0; j<w*h; j++) {
+				int val = surf->luxmap[j].r - 127;
+				val = -val + 127;
+				((rgb_u8_t*)surf->luxmap)[j].r = (u8)val;
+			}
+		}
+	}
+}
+
 static void bsp_qmod_gen_model(bsp_t* const bsp, const u32 model_idx, const mat3s* const bsp_to_world) {
 #ifndef NDEBUG
 		myprintf("[bsp_qmod_gen_model] model_idx:%u\n", model_idx);
@@ -1000,62 +1066,7 @@ static void bsp_qmod_gen_model(bsp_t* const bsp, const u32 model_idx, const mat3
 	}
 #endif
 
-	/* Process Luxmap */
-	/* this is a big fucky wucky mess because I honestly am not fucking sure */
 	const int face_end = qmod->firstmodelsurface+qmod->nummodelsurfaces;
-	for (int i=qmod->firstmodelsurface; i<face_end; i++) {
-		const bsp_face_t* const face = &bsp->faces[i];
-		if (face->lightmap < 0)
-			continue;
-		const bsp_dtexinfo_t* const texinfo = &bsp->texinfo[face->texinfo_id];
-		const bsp_msurface_t* const surf = &bsp->msurfs[i];
-
-#if 0
-		if (texinfo->vectorS.x <= 0)
-			continue;
-		if (texinfo->vectorS.y != 0)
-			continue;
-		if (texinfo->vectorS.z != 0)
-			continue;
-		if (texinfo->distS != 0)
-			continue;
-
-		if (texinfo->vectorT.x != 0)
-			continue;
-		if (texinfo->vectorT.y >= 0)
-			continue;
-		if (texinfo->vectorT.z != 0)
-			continue;
-		if (texinfo->distT != 0)
-			continue;
-
-		if (surf->plane->normal.z >= 0)
-			continue;
-		if (surf->texturemins[1] >= 0)
-			continue;
-
-		print_vec3("vecS", texinfo->vectorS);
-		print_vec3("vecT", texinfo->vectorT);
-		myprintf("norm: %.2fx%.2fx%.2f\n", surf->plane->normal.x, surf->plane->normal.y, surf->plane->normal.z);
-		myprintf("texmins %d %d pdist:%.2f\n", surf->texturemins[0], surf->texturemins[1], surf->plane->dist);
-#endif
-
-		const float dots = glm_vec3_dot(surf->plane->normal.raw, texinfo->vectorS.raw) + surf->plane->dist;
-		const float dott = glm_vec3_dot(surf->plane->normal.raw, texinfo->vectorT.raw) + surf->plane->dist;
-		/* const float dots = glm_vec3_dot(surf->plane->normal.raw, texinfo->vectorS.raw) + texinfo->distS + surf->plane->dist; */
-		/* const float dott = glm_vec3_dot(surf->plane->normal.raw, texinfo->vectorT.raw) + texinfo->distT + surf->plane->dist; */
-		if (dots >= 0 || dott >= 0)
-			continue;
-
-		const int w = (surf->extents[0]>>4)+1;
-		const int h = (surf->extents[1]>>4)+1;
-		for (int j=0; j<w*h; j++) {
-			int val = surf->luxmap[j].r - 127;
-			val = -val + 127;
-			((rgb_u8_t*)surf->luxmap)[j].r = (u8)val;
-		}
-	}
-
 	/* Reset tri_cnt for gen */
 	for (u32 i=0; i<model->mesh_cnt; i++)
 		model->meshes[i].face_cnt = 0;
@@ -1276,6 +1287,7 @@ static void bsp_qmod_gen_model(bsp_t* const bsp, const u32 model_idx, const mat3
 
 int bsp_parse(char* const start, bsp_t* const bsp, const bsp_lux_t* const lux, const assets_t* const assets, alloc_t* const alloc) {
 	bsp_parse_header(start, bsp);
+	bsp_parse_entities(bsp, start+((const bsp_header_t*)start)->entities.offset);
 	if (bsp_alloc(bsp))
 		return 1;
 	const mat3s bsp_to_world={.col={(vec3s){.x=1,.y=0,.z=0},(vec3s){.x=0,.y=0,.z=-1},(vec3s){.x=0,.y=1,.z=0}}};
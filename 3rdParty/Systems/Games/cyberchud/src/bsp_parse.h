@@ -5,6 +5,16 @@
 
 int bsp_parse(char* const start, bsp_t* const bsp, const bsp_lux_t* const lux, const assets_t* const assets, alloc_t* const alloc);
 
+/* the lump pointers and the engine block, shared with the cooked loader in bsp_cook.c */
+void bsp_parse_header(char* const start, bsp_t* const bsp);
+int bsp_alloc(bsp_t* const bsp);
+
+/* the texture name to px table bsp_extract_textures goes through */
+const material_info_t* bsp_materials(u32* const cnt);
+
+/* patches the lux lump, once per level like bsp_transform */
+void bsp_luxmap_fix(const bsp_t* const bsp);
+
 /* called once per BSP to transform from Quake-space */
 void bsp_transform(char* const start);
 
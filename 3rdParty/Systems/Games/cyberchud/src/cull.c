@@ -59,9 +59,9 @@ void job_frustum_cull(engine_t* const e) {
 	const bsp_qmodel_t* const worldmodel = &e->assets.map.qmods[0];
 	const vec3s pos = ecs->pos[ecs->player_id];
 	u8* pvs = SV_FatPVS(pos, worldmodel);
-	for (i32 i=0; i<myarrlen(ecs->flags); i++) {
+	SPARSE_EACH(&ecs->set_model, i) {
 		const flag_t flags = ecs->flags[i];
-		if (!flags.model_mtx || flags.skip_draw)
+		if (flags.skip_draw)
 			continue;
 
 		/* BSP Visflag Cull Models */
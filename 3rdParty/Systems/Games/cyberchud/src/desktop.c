@@ -19,6 +19,7 @@ int main(void) {
 	return 0;
 }
 #else
+#include <stdlib.h>
 #include <string.h>
 int main(const int argc, const char** argv) {
 	init_cfg_t cfg = {0};
@@ -29,6 +30,28 @@ int main(const int argc, const char** argv) {
 			cfg.no_pointlights = 1;
 		} else if (strcmp(argv[i], "-nosc")==0) {
 			cfg.no_shadowcasters = 1;
+		} else if (strcmp(argv[i], "-fbdump")==0 && i+1<argc) {
+			cfg.fb_dump = argv[++i];
+		} else if (strcmp(argv[i], "-headless")==0) {
+			cfg.headless = 1;
+		} else if (strcmp(argv[i], "-cook")==0) {
+			cfg.cook = 1;
+			cfg.headless = 1;
+		} else if (strcmp(argv[i], "-play")==0 && i+1<argc) {
+			cfg.demo_play = argv[++i];
+		} else if (strcmp(argv[i], "-record")==0 && i+1<argc) {
+			cfg.demo_record = argv[++i];
+		} else if (strcmp(argv[i], "-bench")==0 && i+1<argc) {
+			cfg.bench_out = argv[++i];
+		} else if (strcmp(argv[i], "-level")==0 && i+1<argc) {
+			cfg.use_level = 1;
+			cfg.level = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-frames")==0 && i+1<argc) {
+			cfg.frames = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-particles")==0 && i+1<argc) {
+			cfg.particles = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-mobs")==0 && i+1<argc) {
+			cfg.mobs = atoi(argv[++i]);
 		}
 	}
 
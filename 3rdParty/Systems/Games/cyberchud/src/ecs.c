@@ -36,7 +36,7 @@ static const ai_t dynlight_ai_template = {
 };
 
 static inline edict_light_t* new_edict_light(ecs_t *ecs, const int32_t id) {
-	edict_light_t *edict = balloc(&ecs->qcvm.edict_mem, sizeof(edict_light_t));
+	edict_light_t *edict = pool_alloc(&ecs->qcvm.edict_mem);
 	edict->basic.area.prev = NULL;
 	edict->basic.area.next = NULL;
 	edict->basic.id = id;
@@ -49,8 +49,9 @@ static inline edict_light_t* new_edict_light(ecs_t *ecs, const int32_t id) {
 
 static inline void free_edict(ecs_t* ecs, const int32_t id) {
 	bitarr_clear(ecs->bit_edict, id);
+	sparse_del(&ecs->set_edict, id);
 	SV_UnlinkEdict(ecs->edict[id].edict);
-	bfree(&ecs->qcvm.edict_mem, ecs->edict[id].edict);
+	pool_free(&ecs->qcvm.edict_mem, ecs->edict[id].edict);
 	ecs->edict[id].edict = NULL;
 	ecs->qcvm.edict_cnt--;
 }
@@ -101,6 +102,7 @@ static void ecs_resize(ecs_t* ecs, const size_t sz) {
 		ecs->hp[i].hp = -1;
 		ecs->hp[i].max = -1;
 		ecs->anim[i].bone_mtx = NULL;
+		ecs->anim[i].skin = NULL;
 	}
 	const size_t bm_cur_size = bitarr_get_pos(curSize);
 	const size_t bm_new_size = bitarr_get_pos(sz);
@@ -108,17 +110,19 @@ static void ecs_resize(ecs_t* ecs, const size_t sz) {
 	ecs_resize_bm(&ecs->bit_edict, bm_cur_size, bm_new_size);
 	ecs_resize_bm(&ecs->bit_light, bm_cur_size, bm_new_size);
 	ecs_resize_bm(&ecs->bit_light_dynamic, bm_cur_size, bm_new_size);
-	ecs_resize_bm(&ecs->bit_particle, bm_cur_size, bm_new_size);
 	ecs_resize_bm(&ecs->bit_particle_emitter, bm_cur_size, bm_new_size);
 	ecs_resize_bm(&ecs->bit_spawner, bm_cur_size, bm_new_size);
 	ecs_resize_bm(&ecs->bit_simplelight0, bm_cur_size, bm_new_size);
 	ecs_resize_bm(&ecs->bit_simplelight0_arr, bm_cur_size, bm_new_size);
 	ecs_resize_bm(&ecs->bit_simplelight1, bm_cur_size, bm_new_size);
+	sparse_resize(&ecs->set_model, curSize, sz);
+	sparse_resize(&ecs->set_edict, curSize, sz);
 }
 
 edict_t* new_edict(ecs_t *ecs, const int32_t id) {
 	bitarr_set(ecs->bit_edict, id);
-	edict_t *edict = balloc(&ecs->qcvm.edict_mem, sizeof(edict_t));
+	sparse_add(&ecs->set_edict, id);
+	edict_t *edict = pool_alloc(&ecs->qcvm.edict_mem);
 	*edict = (edict_t){0};
 	edict->basic.id = id;
 	edict->basic.num_leafs = 0;
@@ -132,6 +136,7 @@ edict_t* new_edict(ecs_t *ecs, const int32_t id) {
 
 void free_entity(ecs_t* const ecs, const int32_t id) {
 	ecs->flags[id] = (flag_t){0};
+	sparse_del(&ecs->set_model, id);
 	bitarr_clear(ecs->used_bm, id);
 	if (id < ecs->low_id)
 		ecs->low_id = id;
@@ -255,18 +260,55 @@ void ecs_free(ecs_t* const ecs) {
 	arrfree(ecs->model);
 
 	/* TODO we could just free the buddy_alloc instead */
-	for (size_t i=0; i<myarrlenu(ecs->anim); i++) {
-		if (ecs->anim[i].bone_mtx)
-			bfree(&ecs->alloc, ecs->anim[i].bone_mtx);
-	}
+	for (size_t i=0; i<myarrlenu(ecs->anim); i++)
+		anim_free(ecs, i);
 	arrfree(ecs->anim);
 	arrfree(ecs->edict);
+	sparse_free(&ecs->set_model);
+	sparse_free(&ecs->set_edict);
+	arrfree(ecs->iter_buf);
+	particle_pool_free(&ecs->particles);
+	SV_FreeAreaGrid(&ecs->qcvm.area);
+	pool_destroy(&ecs->qcvm.edict_mem);
+}
+
+/* Bone matrices and the skinned vertices, only reallocated when the model needs more */
+void anim_alloc(ecs_t* const ecs, const i32 id, const model_anim_data_t* const model_data) {
+	anim_t* const anim = &ecs->anim[id];
+	const u32 bone_cnt = model_data->basic.bone_cnt;
+	if (anim->bone_mtx == NULL || bone_cnt > anim->bone_mtx_sz) {
+		if (anim->bone_mtx)
+			bfree(&ecs->alloc, anim->bone_mtx);
+		anim->bone_mtx_sz = bone_cnt;
+		anim->bone_mtx = balloc(&ecs->alloc, sizeof(mat4s)*bone_cnt);
+	}
+
+	u32 vert_cnt = 0;
+	for (u32 i=0; i<model_data->basic.mesh_cnt; i++)
+		vert_cnt += model_data->basic.meshes[i].vert_cnt;
+	if (anim->skin == NULL || vert_cnt > anim->skin_sz) {
+		if (anim->skin)
+			bfree(&ecs->alloc, anim->skin);
+		anim->skin_sz = vert_cnt;
+		anim->skin = balloc(&ecs->alloc, sizeof(skin_vert_t)*vert_cnt);
+	}
+	anim->skinned = 0;
+	anim->lod_delta = 0;
+}
+
+void anim_free(ecs_t* const ecs, const i32 id) {
+	anim_t* const anim = &ecs->anim[id];
+	if (anim->bone_mtx)
+		bfree(&ecs->alloc, anim->bone_mtx);
+	if (anim->skin)
+		bfree(&ecs->alloc, anim->skin);
+	anim->bone_mtx = NULL;
+	anim->skin = NULL;
 }
 
 void free_model_anim(ecs_t* const ecs, const i32 id) {
 	free_entity(ecs, id);
-	bfree(&ecs->alloc, ecs->anim[id].bone_mtx);
-	ecs->anim[id].bone_mtx = NULL;
+	anim_free(ecs, id);
 }
 
 #if 0
@@ -293,11 +335,12 @@ void ecs_reset(ecs_t* const ecs) {
 		if (bitarr_get(ecs->bit_edict, i)) {
 			free_edict(ecs, i);
 		}
-		if (flags.bones) {
-			bfree(&ecs->alloc, ecs->anim[i].bone_mtx);
-			ecs->anim[i].bone_mtx = NULL;
-		}
+		if (flags.bones)
+			anim_free(ecs, i);
 	}
+	sparse_clear(&ecs->set_model);
+	sparse_clear(&ecs->set_edict);
+	particle_pool_reset(&ecs->particles);
 	ecs_setlen(ecs, 0);
 	ecs->low_id = 0;
 	ecs_resize(ecs, INITIAL_ECS_CAP);
@@ -326,6 +369,57 @@ void qcvm_resize(qcvm_t* const qcvm) {
 	qcvm->moved_from_buf = (vec3s*)ptr;
 }
 
+static void particle_soa_init(particle_soa_t* const soa, char** const ptr) {
+	const size_t fsz = PARTICLE_MAX*sizeof(float);
+	const size_t isz = PARTICLE_MAX*sizeof(int32_t);
+	soa->x = pad_inc_ptr(ptr, fsz, 64);
+	soa->y = pad_inc_ptr(ptr, fsz, 64);
+	soa->z = pad_inc_ptr(ptr, fsz, 64);
+	soa->vx = pad_inc_ptr(ptr, fsz, 64);
+	soa->vy = pad_inc_ptr(ptr, fsz, 64);
+	soa->vz = pad_inc_ptr(ptr, fsz, 64);
+	soa->ttl = pad_inc_ptr(ptr, fsz, 64);
+	soa->id = pad_inc_ptr(ptr, isz, 64);
+	soa->cell = pad_inc_ptr(ptr, isz, 64);
+}
+
+/* Fixed size, one block holding both SoA buffers and the per tick scratch */
+static void particle_pool_init(particle_pool_t* const pool) {
+	const size_t soa_size = 9*pad_inc_count(PARTICLE_MAX*sizeof(float), 64);
+	size_t byte_size = 2*soa_size;
+	byte_size += 3*pad_inc_count(PARTICLE_MAX*sizeof(float), 64);
+	byte_size += pad_inc_count(PARTICLE_MAX, 64);
+	char* ptr = mymalloc(byte_size+64);
+	pool->mem = ptr;
+	ptr += pad_skip_padding((uintptr_t)ptr, 64);
+	particle_soa_init(&pool->cur, &ptr);
+	particle_soa_init(&pool->tmp, &ptr);
+	pool->end_x = pad_inc_ptr(&ptr, PARTICLE_MAX*sizeof(float), 64);
+	pool->end_y = pad_inc_ptr(&ptr, PARTICLE_MAX*sizeof(float), 64);
+	pool->end_z = pad_inc_ptr(&ptr, PARTICLE_MAX*sizeof(float), 64);
+	pool->inside = pad_inc_ptr(&ptr, PARTICLE_MAX, 64);
+	memset(pool->mem, 0, byte_size+64);
+	pool->cnt = 0;
+	/* myarrlen needs a header */
+	arrsetcap(pool->cells, 256);
+	arrsetcap(pool->cell_lut, 1024);
+	arrsetcap(pool->cell_cnt, 256);
+}
+
+/* Cells are per map, the entities behind the particles are freed by ecs_reset itself */
+void particle_pool_reset(particle_pool_t* const pool) {
+	pool->cnt = 0;
+	arrsetlen(pool->cells, 0);
+	arrsetlen(pool->cell_lut, 0);
+}
+
+static void particle_pool_free(particle_pool_t* const pool) {
+	myfree(pool->mem);
+	arrfree(pool->cells);
+	arrfree(pool->cell_lut);
+	arrfree(pool->cell_cnt);
+}
+
 static void qcvm_init(qcvm_t* const qcvm) {
 #define QCVM_INIT_CAP 1024
 	qcvm->buf_cap = QCVM_INIT_CAP;
@@ -341,23 +435,36 @@ void ecs_init(ecs_t* const ecs) {
 	/* Init ECS Capacity */
 	ecs_resize(ecs, INITIAL_ECS_CAP);
 	qcvm_init(&ecs->qcvm);
+	particle_pool_init(&ecs->particles);
 }
 
 void free_particle(ecs_t* const ecs, const int32_t id) {
 	bitarr_clear(ecs->bit_simplelight0, id);
 	free_entity(ecs, id);
-	bitarr_clear(ecs->bit_particle, id);
 }
 
+/* Returns -1 when the pool is full, callers treat particles as best effort */
 int32_t new_particle(ecs_t *ecs, const vec3s* pos, const vec3s* vel, const model_basic_t* const model, const float brightness) {
+	particle_pool_t* const pool = &ecs->particles;
+	if (pool->cnt >= PARTICLE_MAX)
+		return -1;
 	const i32 id = new_model_static(ecs, model, pos);
 	if (brightness > 0) {
 		bitarr_set(ecs->bit_simplelight0, id);
 		ecs->brightness[id] = brightness;
 	}
-	ecs->vel[id] = *vel;
-	bitarr_set(ecs->bit_particle, id);
-	ecs->cooldown0[id] = 1;
+
+	particle_soa_t* const p = &pool->cur;
+	const i32 i = pool->cnt++;
+	p->x[i] = pos->x;
+	p->y[i] = pos->y;
+	p->z[i] = pos->z;
+	p->vx[i] = vel->x;
+	p->vy[i] = vel->y;
+	p->vz[i] = vel->z;
+	p->ttl[i] = 1;
+	p->id[i] = id;
+	p->cell[i] = -1;
 	return id;
 }
 
@@ -433,7 +540,7 @@ static int32_t new_bsp(ecs_t* ecs, bsp_t *bsp, const u32 qmod_idx) {
 #ifndef NDEBUG
 	myprintf("[new_bsp] %d\n", id);
 #endif
-	ecs->flags[id].model_mtx = 1;
+	ecs_add_model_mtx(ecs, id);
 	ecs->flags[id].tangent = 1;
 	ecs->pos[id] = bsp->dmodels[qmod_idx].origin;
 	ecs->vel[id] = (vec3s){.x=0,.y=0,.z=0};
@@ -522,7 +629,7 @@ int32_t new_model_static(ecs_t* ecs, const model_basic_t* const model_data, cons
 	myprintf("[new_model_static] pos: %fx%fx%f\n", pos->x, pos->y, pos->z);
 #endif
 	const i32 id = new_entity(ecs);
-	ecs->flags[id].model_mtx = 1;
+	ecs_add_model_mtx(ecs, id);
 	ecs->flags[id].tangent = 1;
 	ecs->pos[id] = *pos;
 	ecs->vel[id] = (vec3s){.x=0,.y=0,.z=0};
@@ -538,10 +645,6 @@ void model_anim_change_model(ecs_t* const ecs, const i32 id, model_anim_data_t*
 	ecs->anim[id].length = anim_data->length;
 	ecs->anim[id].data = anim_data;
 	ecs->anim[id].next = NULL;
-	if (model_data->basic.bone_cnt > ecs->anim[id].bone_mtx_sz) {
-		ecs->anim[id].bone_mtx_sz = model_data->basic.bone_cnt;
-		bfree(&ecs->alloc, ecs->anim[id].bone_mtx);
-		ecs->anim[id].bone_mtx = balloc(&ecs->alloc, sizeof(mat4s)*model_data->basic.bone_cnt);
-	}
+	anim_alloc(ecs, id, model_data);
 	ecs->model[id].model_anim = model_data;
 }
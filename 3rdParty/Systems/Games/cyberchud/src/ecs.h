@@ -4,6 +4,7 @@
 #include "ai.h"
 #include "bsp.h"
 #include "dialogue.h"
+#include "sparse.h"
 
 typedef enum {
 	TYPE_NONE,
@@ -147,6 +148,43 @@ typedef struct {
 	int16_t dmg;
 } projectile_t;
 
+/* Particles live in their own SoA pool instead of the entity slots, only the
+ * model drawing them is an entity. particle.c keeps them sorted by the hull
+ * cell they sit in so a step that stays inside the cell skips the hull trace. */
+#define PARTICLE_MAX 16384
+#define PARTICLE_CELL_PLANES 48
+
+typedef struct {
+	float* x;
+	float* y;
+	float* z;
+	float* vx;
+	float* vy;
+	float* vz;
+	float* ttl;
+	int32_t* id; // model entity, -1 once freed
+	int32_t* cell; // index into cells, -1 needs a full trace
+} particle_soa_t;
+
+typedef struct {
+	int32_t plane_cnt;
+	vec4s planes[PARTICLE_CELL_PLANES]; // flipped so inside is dot(p)-w > 0
+} particle_cell_t;
+
+typedef struct {
+	int32_t cnt;
+	particle_soa_t cur;
+	particle_soa_t tmp; // counting sort target, swapped with cur
+	float* end_x; // this tick's unclipped end points
+	float* end_y;
+	float* end_z;
+	u8* inside; // end point still in the cached cell
+	particle_cell_t* cells;
+	int32_t* cell_lut; // (clipnode<<1|side) -> cells
+	int32_t* cell_cnt; // sort scratch
+	char* mem;
+} particle_pool_t;
+
 /* Unions */
 
 /* Ideally this union should be exactly 64 bytes and store unique type information */
@@ -204,11 +242,17 @@ typedef struct {
 	/* Heap */
 	alloc_t alloc;
 
+	/* Packed Members, iterate these instead of every slot */
+	sparse_t set_model; // flags.model_mtx
+	sparse_t set_edict; // bit_edict
+	int32_t* iter_buf; // snapshot for loops that spawn/free entities
+
+	particle_pool_t particles;
+
 	/* Free List */
 	BITARR_TYPE* bit_edict;
 	BITARR_TYPE* bit_light;
 	BITARR_TYPE* bit_light_dynamic;
-	BITARR_TYPE* bit_particle;
 	BITARR_TYPE* bit_particle_emitter;
 	BITARR_TYPE* bit_spawner;
 	BITARR_TYPE* bit_simplelight0; // top priority
@@ -237,14 +281,22 @@ int32_t new_bsp_worldmodel(ecs_t* const ecs, bsp_t* const bsp, const u32 qmod_id
 void ecs_free(ecs_t* const ecs);
 void ecs_init(ecs_t* const ecs);
 void ecs_reset(ecs_t* const ecs);
+void anim_alloc(ecs_t* const ecs, const i32 id, const model_anim_data_t* const model_data);
+void anim_free(ecs_t* const ecs, const i32 id);
 void free_mob(ecs_t* const ecs, const i32 id);
 void free_particle(ecs_t* const ecs, const int32_t id);
+void particle_pool_reset(particle_pool_t* const pool);
 void free_rocket(ecs_t* const ecs, const int32_t id);
 void free_beam(ecs_t* const ecs, const i32 id);
 void free_bsp_trigger(ecs_t* const ecs, const int32_t id);
 
 void qcvm_resize(qcvm_t* const qcvm);
 
+static inline void ecs_add_model_mtx(ecs_t* const ecs, const int32_t id) {
+	ecs->flags[id].model_mtx = 1;
+	sparse_add(&ecs->set_model, id);
+}
+
 void model_anim_change_model(ecs_t* const ecs, const i32 id, model_anim_data_t* const model_data, const anim_data_t* const anim_data);
 
 #endif
@@ -44,7 +44,7 @@ int32_t new_model_anim(engine_t* e, const model_anim_data_t* const model_data, c
 	ecs_t* const ecs = &e->ecs;
 	const i32 id = new_entity(ecs);
 	ecs->flags[id].bones = 1;
-	ecs->flags[id].model_mtx = 1;
+	ecs_add_model_mtx(ecs, id);
 	ecs->flags[id].tangent = 1;
 	ecs->pos[id] = pos;
 	ecs->vel[id] = (vec3s){.x=0,.y=0,.z=0};
@@ -56,8 +56,7 @@ int32_t new_model_anim(engine_t* e, const model_anim_data_t* const model_data, c
 	ecs->anim[id].length = anim_data->length;
 	ecs->anim[id].data = anim_data;
 	ecs->anim[id].next = NULL;
-	ecs->anim[id].bone_mtx_sz = model_data->basic.bone_cnt;
-	ecs->anim[id].bone_mtx = balloc(&ecs->alloc, sizeof(mat4s)*model_data->basic.bone_cnt);
+	anim_alloc(ecs, id, model_data);
 	return id;
 }
 
@@ -579,7 +578,7 @@ engine_threads_t* engine_alloc(const i8 cpu_cnt) {
 
 	/* Setup Allocators */
 	alloc_init(&e->ecs.alloc, 16, 1024*1024*32);
-	alloc_init(&e->ecs.qcvm.edict_mem, 8, sizeof(edict_t)*1024*10);
+	pool_init(&e->ecs.qcvm.edict_mem, MAX(sizeof(edict_t), sizeof(edict_light_t)), 1024);
 
 	/* Linear Buffers */
 	arrsetcap(e->lines, 1024);
@@ -598,6 +597,7 @@ void engine_free(engine_threads_t* const et) {
 	DestroyCond(et->jobs[0].done_mu_cond);
 
 	assets_free(&e->assets);
+	light_probes_free(&e->probes);
 
 	ecs_free(&e->ecs);
 }
@@ -10,6 +10,7 @@
 #include "assets.h"
 #include "controls.h"
 #include "ecs.h"
+#include "lightprobe.h"
 #include "mytime.h"
 #include "palette.h"
 #include "sound.h"
@@ -56,6 +57,8 @@ typedef enum {
 	JOB_STATE_VERTS,
 	JOB_STATE_SHADOW,
 	JOB_STATE_FRAG,
+	JOB_STATE_WAD,
+	JOB_STATE_PROBES,
 	JOB_STATE_QUIT,
 } JOB_STATE;
 
@@ -166,6 +169,7 @@ typedef struct {
 	hull_box_t hb;
 	palette_t palette;
 	palette_t palette_base;
+	palette_quant_t quant;
 	plane_t* world_colliders;
 
 	/* Perf Timers */
@@ -176,6 +180,10 @@ typedef struct {
 	float time_ai;
 	float time_ai_light;
 	float time_absbox;
+	float time_bones; // wall time of each job as seen by the main thread
+	float time_verts;
+	float time_shadow;
+	float time_frag;
 
 	/* Shared Scene UI Buffers */
 	UI_MODE ui_mode;
@@ -202,9 +210,11 @@ typedef struct {
 
 	/* Buffers */
 	visflags_t visflags[MAX_VISFLAGS];
+	light_probes_t probes; // model ambient, reset by SV_ClearWorld
 	size_t cull_tri_cnt;
 	uint32_t* idxs_culled; // scratch for update
 	uint32_t* idxs_bones;
+	u32 anim_frame; // staggers the animation LOD
 
 	/* Simplelight Buffer */
 	i8 simplelight_cnt;
@@ -3,6 +3,8 @@
 
 #include <SDL2/SDL.h>
 
+#include "bench.h"
+#include "bsp_cook.h"
 #include "game.h"
 #include "render.h"
 #include "engine.h"
@@ -15,6 +17,11 @@
 #include "utils/minmax.h"
 
 engine_threads_t* ge;
+#ifdef PLATFORM_DESKTOP
+static FILE* g_fb_dump;
+static bench_t* g_bench; // NULL unless a demo, level or bench was asked for
+static int g_headless;
+#endif
 
 #if 0
 #include "palette.h"
@@ -71,6 +78,8 @@ EMSCRIPTEN_KEEPALIVE void window_focus_callback() {
 	}
 #endif
 
+#define TICK_TIME 0.01666666666f
+
 static inline SDL_Surface* get_winsurf(SDL_Window* win) {
 	SDL_Surface* const surf = SDL_GetWindowSurface(win);
 #ifndef NDEBUG
@@ -80,58 +89,8 @@ static inline SDL_Surface* get_winsurf(SDL_Window* win) {
 	return surf;
 }
 
-void DLL_PUBLIC loop(void) {
-#ifdef VERBOSE
-	fputs("[LOOP]\n", stdout);
-#endif
-	engine_threads_t* const et = ge;
+static void present(engine_threads_t* const et, const float delta) {
 	engine_t* const e = &et->e;
-	e->ticks_last = e->ticks_cur;
-	e->ticks_cur = get_time();
-	float delta = time_diff(e->ticks_last, e->ticks_cur);
-	if (delta > 1.0f) delta = 1.0f;
-
-#define TICK_TIME 0.01666666666f
-	e->ticks_accum += delta;
-	const int ticks = e->ticks_accum/TICK_TIME;
-	e->ticks_accum -= ticks*TICK_TIME;
-
-	for (int i=0; i<ticks; i++) {
-		if (e->switch_scene) {
-			e->switch_scene = 0;
-			engine_cfg_update(e);
-			switch (e->scene) {
-				case SCENE_TITLE:
-					title_init(e);
-					break;
-				case SCENE_PLAYFIELD:
-					playfield_init(e);
-					break;
-			}
-		}
-
-		input(&e->controls);
-
-		switch (e->scene) {
-			case SCENE_TITLE:
-				title_update(e, TICK_TIME);
-				break;
-			case SCENE_PLAYFIELD:
-				playfield_update(e, TICK_TIME);
-				break;
-		}
-		e->scene_time += TICK_TIME;
-	}
-
-	switch (e->scene) {
-		case SCENE_TITLE:
-			title_draw(et, delta);
-			break;
-		case SCENE_PLAYFIELD:
-			playfield_draw(et, delta);
-			break;
-	}
-
 #if defined(HW_ACCEL) && !defined(TOSLIKE)
 	/* Hardware Path */
 	SDL_Rect rect = {.x=0, .y=0, .w=SCREEN_W, .h=SCREEN_H};
@@ -218,11 +177,109 @@ void DLL_PUBLIC loop(void) {
 	/* }; */
 #endif /* defined(PLATFORM_DESKTOP) || defined(__EMSCRIPTEN__) */
 #endif /* End Software Path */
+}
+
+void DLL_PUBLIC loop(void) {
+#ifdef VERBOSE
+	fputs("[LOOP]\n", stdout);
+#endif
+	engine_threads_t* const et = ge;
+	engine_t* const e = &et->e;
+	e->ticks_last = e->ticks_cur;
+	e->ticks_cur = get_time();
+	float delta = time_diff(e->ticks_last, e->ticks_cur);
+	if (delta > 1.0f) delta = 1.0f;
+
+	e->ticks_accum += delta;
+	int ticks = e->ticks_accum/TICK_TIME;
+	e->ticks_accum -= ticks*TICK_TIME;
+#ifdef PLATFORM_DESKTOP
+	/* one tick per frame so a demo replays the same frames on any machine */
+	if (g_headless) {
+		delta = TICK_TIME;
+		ticks = 1;
+	}
+#endif
+
+	for (int i=0; i<ticks; i++) {
+		if (e->switch_scene) {
+			e->switch_scene = 0;
+			engine_cfg_update(e);
+			switch (e->scene) {
+				case SCENE_TITLE:
+					title_init(e);
+					break;
+				case SCENE_PLAYFIELD:
+					playfield_init(e);
+					break;
+			}
+		}
+
+#ifdef PLATFORM_DESKTOP
+		if (g_bench && g_bench->demo_in) {
+			if (!bench_input(g_bench, &e->controls))
+				break;
+		} else {
+			input(&e->controls);
+		}
+		if (g_bench && g_bench->demo_out)
+			bench_record(g_bench, &e->controls);
+		if (g_bench && (g_bench->particles || g_bench->mobs))
+			bench_tick(g_bench, e);
+#else
+		input(&e->controls);
+#endif
+
+		switch (e->scene) {
+			case SCENE_TITLE:
+				title_update(e, TICK_TIME);
+				break;
+			case SCENE_PLAYFIELD:
+				playfield_update(e, TICK_TIME);
+				break;
+		}
+		e->scene_time += TICK_TIME;
+	}
+
+#ifdef PLATFORM_DESKTOP
+	/* the demo ran out on this tick, don't draw or time a frame past its end */
+	if (g_bench && g_bench->demo_in && g_bench->done)
+		return;
+#endif
+
+	switch (e->scene) {
+		case SCENE_TITLE:
+			title_draw(et, delta);
+			break;
+		case SCENE_PLAYFIELD:
+			playfield_draw(et, delta);
+			break;
+	}
+
+#ifdef PLATFORM_DESKTOP
+	if (g_headless)
+		bench_frame(g_bench, e, bench_present(g_bench, e));
+	else
+		present(et, delta);
+	if (g_bench && !g_headless)
+		bench_frame(g_bench, e, 0);
+#else
+	present(et, delta);
+#endif
+
+#ifdef PLATFORM_DESKTOP
+	if (g_fb_dump)
+		fwrite(e->fb_real, SCREEN_W*SCREEN_H, 1, g_fb_dump);
+#endif
 
 	e->interlace = !e->interlace;
 }
 
 int check_if_quitting(void) {
+#ifdef PLATFORM_DESKTOP
+	if (g_bench && g_bench->done)
+		return 1;
+#endif
 	return ge->e.controls.close;
 }
 
@@ -238,7 +295,13 @@ int DLL_PUBLIC init(init_cfg_t cfg) {
 #endif
 
 	/* Init SDL */
-	if (SDL_Init(SDL_INIT_VIDEO|SDL_INIT_EVENTS|SDL_INIT_AUDIO) != 0) {
+#ifdef PLATFORM_DESKTOP
+	g_headless = cfg.headless;
+	const Uint32 sdl_flags = g_headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO|SDL_INIT_EVENTS|SDL_INIT_AUDIO;
+#else
+	const Uint32 sdl_flags = SDL_INIT_VIDEO|SDL_INIT_EVENTS|SDL_INIT_AUDIO;
+#endif
+	if (SDL_Init(sdl_flags) != 0) {
 		/* fprintf(stderr, "SDL_Init Error: %s\n", SDL_GetError()); */
 		return 1;
 	}
@@ -265,6 +328,19 @@ int DLL_PUBLIC init(init_cfg_t cfg) {
 	if (ge == NULL)
 		return 1;
 
+#ifdef PLATFORM_DESKTOP
+	if (cfg.fb_dump) {
+		g_fb_dump = fopen(cfg.fb_dump, "wb");
+		if (!g_fb_dump)
+			myprintf("[ERR] can't open %s for writing\n", cfg.fb_dump);
+	}
+	if (cfg.headless || cfg.use_level || cfg.demo_play || cfg.demo_record || cfg.bench_out || cfg.frames || cfg.particles || cfg.mobs) {
+		g_bench = calloc(1, sizeof(bench_t));
+		if (g_bench == NULL || bench_init(g_bench, &cfg))
+			return 1;
+	}
+#endif
+
 	/* Init Engine */
 	engine_t* const e = &ge->e;
 	e->controls.win_size.x = SCREEN_W;
@@ -277,6 +353,12 @@ int DLL_PUBLIC init(init_cfg_t cfg) {
 	e->max_shadowcasters = 2;
 	e->flags.pointlight_shadows_enabled = !cfg.no_pointlights;
 	e->flags.shadowcaster_shadows_enabled = !cfg.no_pointlights;
+#ifdef PLATFORM_DESKTOP
+	if (g_bench && g_bench->level >= 0) {
+		e->scene = SCENE_PLAYFIELD;
+		e->current_level = g_bench->level;
+	}
+#endif
 
 	/* Init Cubemaps */
 	for (int i=0; i<MAX_DYNAMIC_LIGHTS; i++)
@@ -294,6 +376,10 @@ int DLL_PUBLIC init(init_cfg_t cfg) {
 	ecs_init(&e->ecs);
 
 	/* Create Window */
+#ifdef PLATFORM_DESKTOP
+	if (g_headless)
+		goto headless_skip_window;
+#endif
 	e->win = SDL_CreateWindow("CyberChud", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_W, SCREEN_H,
 #if !defined(__EMSCRIPTEN__) && !defined(TOSLIKE)
 		SDL_WINDOW_RESIZABLE
@@ -324,6 +410,9 @@ int DLL_PUBLIC init(init_cfg_t cfg) {
 	SDL_UpdateWindowSurface(e->win);
 #endif
 #endif
+#ifdef PLATFORM_DESKTOP
+headless_skip_window:
+#endif
 
 #ifdef TOSLIKE
 	/* Init Special TOSLIKE Sound System (BEFORE THREADS!) */
@@ -341,15 +430,41 @@ int DLL_PUBLIC init(init_cfg_t cfg) {
 	tosfb_init(&ge->tosfb_thr, e, &e->palette);
 #endif
 
-	/* Load Assets */
+	/* Load Assets, the workers decompress what the title needs and the levels stream in behind it */
+	const TIME_TYPE load_start = get_time();
+	if (assets_open(&e->assets)) {
+		fputs("[INIT] FATAL\n", stdout);
+		return 1;
+	}
+	const TIME_TYPE load_open = get_time();
+	thread_set_and_go(ge, JOB_STATE_WAD);
+	const TIME_TYPE load_lumps = get_time();
 	if (assets_init(&e->assets, &e->ecs.alloc)) {
 		fputs("[INIT] FATAL\n", stdout);
 		return 1;
 	}
+	const TIME_TYPE load_end = get_time();
+	myprintf("[INIT] cold start open:%.2fms lumps:%.2fms parse:%.2fms total:%.2fms\n",
+		time_diff(load_start, load_open)*1000.0f, time_diff(load_open, load_lumps)*1000.0f,
+		time_diff(load_lumps, load_end)*1000.0f, time_diff(load_start, load_end)*1000.0f);
 #ifndef NDEBUG
 	fputs("[INIT] load done\n", stdout);
 #endif
 
+#ifdef PLATFORM_DESKTOP
+	if (g_headless) {
+#ifdef BSP_COOK
+		if (cfg.cook) {
+			if (assets_cook_levels(&e->assets, &e->ecs.alloc))
+				return 1;
+			e->controls.close = 1;
+		}
+#endif
+		e->ticks_cur = get_time();
+		return 0;
+	}
+#endif
+
 	/* Init Audio */
 	/* web browsers wont let us open an audio device until the user interacts with the page */
 	e->audio.spec.freq  = SND_FREQ;
@@ -439,6 +554,15 @@ int DLL_PUBLIC quit(void) {
 
 	engine_free(et);
 
+#ifdef PLATFORM_DESKTOP
+	if (g_fb_dump)
+		fclose(g_fb_dump);
+	if (g_bench) {
+		bench_finish(g_bench);
+		free(g_bench);
+	}
+#endif
+
 	SDL_Quit();
 #ifndef NDEBUG
 	fputs("[quit] done\n", stdout);
@@ -6,6 +6,17 @@
 typedef struct {
 	unsigned int no_pointlights: 1;
 	unsigned int no_shadowcasters: 1;
+	unsigned int headless: 1; // no window or audio, frames only go to the bench
+	unsigned int use_level: 1; // skip the title and start on level
+	unsigned int cook: 1; // write level%02d.cook for every level then quit
+	int level;
+	int frames; // stop after this many frames, 0 runs until the demo ends
+	int particles; // keep this many particles alive around the player
+	int mobs; // spawn this many chuds around the player when the level starts
+	const char* fb_dump; // append every presented framebuffer here, for tools/vgabench
+	const char* demo_play; // replay recorded controls instead of reading input
+	const char* demo_record;
+	const char* bench_out; // per frame timings, .json or csv
 } init_cfg_t;
 
 int DLL_PUBLIC init(init_cfg_t cfg);
@@ -0,0 +1,163 @@
+#include <math.h>
+#include "lightprobe.h"
+#include "quake.h"
+#include "text.h"
+#include "utils/mymalloc.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+
+static inline i32 light_probes_cnt(const light_probes_t* const probes) {
+	return probes->w*probes->h*probes->d;
+}
+
+static inline vec3s light_probes_pos(const light_probes_t* const probes, const i32 x, const i32 y, const i32 z) {
+	return (vec3s){{
+		probes->origin.x + x*probes->spacing,
+		probes->origin.y + y*probes->spacing,
+		probes->origin.z + z*probes->spacing,
+	}};
+}
+
+/* Sizes the grid to the world model, the bake happens on the next rendered frame if the grid could be allocated */
+void light_probes_reset(light_probes_t* const probes, const bsp_t* const bsp) {
+	const bbox_t* const bounds = &bsp->qmods[0].bbox;
+	const vec3s size = glms_vec3_sub(bounds->max, bounds->min);
+
+	probes->ready = 0;
+	probes->origin = bounds->min;
+	probes->spacing = LIGHT_PROBE_SPACING;
+	for (;;) {
+		probes->w = MAX(1, (i32)ceilf(size.x/probes->spacing) + 1);
+		probes->h = MAX(1, (i32)ceilf(size.y/probes->spacing) + 1);
+		probes->d = MAX(1, (i32)ceilf(size.z/probes->spacing) + 1);
+		if ((i64)probes->w*probes->h*probes->d <= LIGHT_PROBE_MAX)
+			break;
+		probes->spacing *= 1.25f;
+	}
+
+	const i32 cnt = light_probes_cnt(probes);
+	if (cnt > probes->cap) {
+		if (probes->light)
+			myfree(probes->light);
+		probes->light = mymalloc(cnt*sizeof(float));
+		probes->cap = cnt;
+		if (probes->light == NULL) {
+			/* never baked, light_probes_sample keeps tracing R_LightPoint */
+			myprintf("[ERR] [light_probes_reset] can't alloc %d probes\n", cnt);
+			probes->cap = 0;
+			return;
+		}
+	}
+#ifndef NDEBUG
+	myprintf("[light_probes_reset] %dx%dx%d spacing:%.2f\n", probes->w, probes->h, probes->d, probes->spacing);
+#endif
+}
+
+/* Each worker takes a contiguous run of probes, no two write the same one */
+void light_probes_bake(light_probes_t* const probes, const bsp_t* const bsp, const i32 slice, const i32 slice_cnt) {
+	const hull_t* const hull = &bsp->qmods[0].hulls[0];
+	const i32 cnt = light_probes_cnt(probes);
+	const i32 start = (i32)((i64)cnt*slice/slice_cnt);
+	const i32 end = (i32)((i64)cnt*(slice+1)/slice_cnt);
+	const i32 wh = probes->w*probes->h;
+
+	lightcache_t cache = {0};
+	for (i32 i=start; i<end; i++) {
+		const i32 z = i / wh;
+		const i32 y = (i - z*wh) / probes->w;
+		const i32 x = i - z*wh - y*probes->w;
+		const vec3s p = light_probes_pos(probes, x, y, z);
+		if (SV_HullPointContents(hull, hull->firstclipnode, p) == CONTENTS_SOLID) {
+			probes->light[i] = LIGHT_PROBE_SOLID;
+			continue;
+		}
+		cache.surfidx = 0;
+		probes->light[i] = R_LightPoint(bsp, p, 0, &cache);
+	}
+}
+
+/* Trilinear blend of the 8 probes around p.y+ofs, probes in solid drop out and the rest are renormalized */
+float light_probes_sample(const light_probes_t* const probes, const bsp_t* const bsp, const vec3s p, const float ofs) {
+	if (!probes->ready) {
+		lightcache_t cache = {0};
+		return R_LightPoint(bsp, p, ofs, &cache);
+	}
+
+	const float inv = 1.0f/probes->spacing;
+	const float fx = glm_clamp((p.x - probes->origin.x)*inv, 0, probes->w-1);
+	const float fy = glm_clamp((p.y + ofs - probes->origin.y)*inv, 0, probes->h-1);
+	const float fz = glm_clamp((p.z - probes->origin.z)*inv, 0, probes->d-1);
+	const i32 x0 = MIN((i32)fx, MAX(probes->w-2, 0));
+	const i32 y0 = MIN((i32)fy, MAX(probes->h-2, 0));
+	const i32 z0 = MIN((i32)fz, MAX(probes->d-2, 0));
+	const i32 x1 = MIN(x0+1, probes->w-1);
+	const i32 y1 = MIN(y0+1, probes->h-1);
+	const i32 z1 = MIN(z0+1, probes->d-1);
+	const float tx = fx - x0, ty = fy - y0, tz = fz - z0;
+
+	const i32 xs[2] = {x0, x1}, ys[2] = {y0, y1}, zs[2] = {z0, z1};
+	const float wx[2] = {1.0f-tx, tx}, wy[2] = {1.0f-ty, ty}, wz[2] = {1.0f-tz, tz};
+
+	float sum = 0, weight = 0;
+	for (i32 k=0; k<2; k++) {
+		for (i32 j=0; j<2; j++) {
+			const float* const row = probes->light + (zs[k]*probes->h + ys[j])*probes->w;
+			for (i32 i=0; i<2; i++) {
+				const float v = row[xs[i]];
+				if (v < 0)
+					continue;
+				const float w = wx[i]*wy[j]*wz[k];
+				sum += v*w;
+				weight += w;
+			}
+		}
+	}
+
+	if (weight < 1e-3f) {
+		lightcache_t cache = {0};
+		return R_LightPoint(bsp, p, ofs, &cache);
+	}
+	return sum / weight;
+}
+
+/* Compares the grid against the trace it replaces at cell centers, debug builds only */
+void light_probes_validate(const light_probes_t* const probes, const bsp_t* const bsp) {
+#ifndef NDEBUG
+	const hull_t* const hull = &bsp->qmods[0].hulls[0];
+	const i32 stride = MAX(1, MAX(probes->w, MAX(probes->h, probes->d))/16);
+	const float half = probes->spacing*0.5f;
+
+	double err_sum = 0;
+	float err_max = 0;
+	i32 cnt = 0;
+	for (i32 z=0; z<probes->d-1; z+=stride) {
+		for (i32 y=0; y<probes->h-1; y+=stride) {
+			for (i32 x=0; x<probes->w-1; x+=stride) {
+				const vec3s p = glms_vec3_adds(light_probes_pos(probes, x, y, z), half);
+				if (SV_HullPointContents(hull, hull->firstclipnode, p) == CONTENTS_SOLID)
+					continue;
+				lightcache_t cache = {0};
+				const float ref = R_LightPoint(bsp, p, 0, &cache);
+				const float err = fabsf(light_probes_sample(probes, bsp, p, 0) - ref);
+				err_sum += err;
+				err_max = MAX(err_max, err);
+				cnt++;
+			}
+		}
+	}
+	myprintf("[light_probes_validate] samples:%d mean_err:%.4f max_err:%.4f\n", cnt, cnt ? err_sum/cnt : 0.0, err_max);
+#else
+	(void)probes;
+	(void)bsp;
+#endif
+}
+
+void light_probes_free(light_probes_t* const probes) {
+	if (probes->light == NULL)
+		return;
+	myfree(probes->light);
+	probes->light = NULL;
+	probes->cap = 0;
+	probes->ready = 0;
+}
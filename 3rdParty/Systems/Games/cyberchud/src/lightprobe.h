@@ -0,0 +1,29 @@
+#ifndef LIGHTPROBE_H
+#define LIGHTPROBE_H
+
+#include "bsp.h"
+
+/* Fixed spacing grid of R_LightPoint samples over the world model, models light from a trilinear lookup.
+ * Baked by JOB_STATE_PROBES on the first frame after SV_ClearWorld, R_LightPoint stays as the fallback. */
+#define LIGHT_PROBE_SPACING (64.0f/BSP_RESIZE_DIV)
+#define LIGHT_PROBE_MAX (1<<19) // spacing grows on maps that would need more
+#define LIGHT_PROBE_SOLID -1.0f
+
+typedef struct {
+	vec3s origin;
+	float spacing;
+	i32 w; // x
+	i32 h; // y
+	i32 d; // z
+	i32 cap;
+	unsigned int ready: 1;
+	float* light; // w*h*d, LIGHT_PROBE_SOLID where the probe is inside the world
+} light_probes_t;
+
+void light_probes_reset(light_probes_t* const probes, const bsp_t* const bsp);
+void light_probes_bake(light_probes_t* const probes, const bsp_t* const bsp, const i32 slice, const i32 slice_cnt);
+float light_probes_sample(const light_probes_t* const probes, const bsp_t* const bsp, const vec3s p, const float ofs);
+void light_probes_validate(const light_probes_t* const probes, const bsp_t* const bsp);
+void light_probes_free(light_probes_t* const probes);
+
+#endif
@@ -1,3 +1,5 @@
+#include <assert.h>
+
 #include "palette.h"
 #include "vec.h"
 #include "utils/minmax.h"
@@ -201,3 +203,29 @@ void palette_scale(palette_t* const palette, palette_t* const palette_base, cons
 		palette->colors[i].rgba.b = palette_base->colors[i].rgba.b * scale;
 	}
 }
+
+/* pulse is the screen pulse phase (0-1), it brightens the shaded half before quantizing */
+void palette_quant_build(palette_quant_t* const quant, const float pulse) {
+	const uint8_t alt_idx_lookup[4] = {0, 13, 14, 15};
+	for (int i=0; i<256; i++) {
+		uint8_t val = i;
+		if (!(val&128)) {
+			val += 64.0f*pulse;
+			if (val > 127) val = 127;
+			val = (float)val/(127.0f/10.0f);
+		} else {
+			const size_t pal_idx = (float)val/(255.0f/3.0f);
+			val = alt_idx_lookup[pal_idx];
+		}
+		assert(val < PALETTE_SIZE);
+		quant->lut[i] = val;
+	}
+
+	quant->step_cnt = 0;
+	for (int i=1; i<256; i++) {
+		assert(quant->lut[i] >= quant->lut[i-1]);
+		for (int s=quant->lut[i-1]; s<quant->lut[i]; s++)
+			quant->steps[quant->step_cnt++] = i;
+	}
+	quant->pulse = pulse;
+}
@@ -21,7 +21,17 @@ typedef struct {
 	palette_color_t colors[PALETTE_SIZE];
 } palette_t;
 
+/* Fragment byte to palette index, rebuilt whenever the screen pulse moves.
+ * The table only ever steps up, steps[] holds where so SIMD can count compares instead of gathering. */
+typedef struct {
+	uint8_t lut[256];
+	uint8_t steps[PALETTE_SIZE];
+	uint8_t step_cnt;
+	float pulse;
+} palette_quant_t;
+
 void palette_randomize(palette_t* palette, xorshift_t* seed);
 void palette_scale(palette_t* const palette, palette_t* const palette_base, const float scale);
+void palette_quant_build(palette_quant_t* const quant, const float pulse);
 
 #endif
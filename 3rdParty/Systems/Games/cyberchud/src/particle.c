@@ -1,3 +1,8 @@
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "particle.h"
 #include "quake.h"
 #include "utils/minmax.h"
@@ -6,48 +11,221 @@
 #define PARTICLE_GRAVITY 10.0f
 #define PARTICLE_DRAG 1.0f
 
+/* Walk the point down hull 0 and remember the planes on the way, that list bounds the convex cell it ends up in.
+ * Only empty cells are cached, anything else (water, solid, too deep) keeps taking the full trace. */
+static i32 particle_find_cell(particle_pool_t* const pool, const hull_t* const hull, const vec3s p) {
+	particle_cell_t cell;
+	cell.plane_cnt = 0;
+	i32 num = hull->firstclipnode;
+	i32 key = -1;
+	while (num >= 0) {
+		const bsp_clipnode_t* const node = hull->clipnodes + num;
+		const bsp_plane_t* const plane = hull->planes + node->planenum;
+		const float d = glms_vec3_dot(plane->normal, p) - plane->dist;
+		const int side = d < 0;
+		if (cell.plane_cnt < PARTICLE_CELL_PLANES) {
+			vec4s* const out = &cell.planes[cell.plane_cnt];
+			const float sign = side ? -1.0f : 1.0f;
+			out->x = plane->normal.x*sign;
+			out->y = plane->normal.y*sign;
+			out->z = plane->normal.z*sign;
+			out->w = plane->dist*sign;
+		}
+		cell.plane_cnt++;
+		key = num<<1 | side;
+		num = node->children[side];
+	}
+	if (num != CONTENTS_EMPTY || key < 0 || cell.plane_cnt > PARTICLE_CELL_PLANES)
+		return -1;
+
+	if (myarrlen(pool->cell_lut) == 0) {
+		arrsetlen(pool->cell_lut, (hull->lastclipnode+1)*2);
+		for (i32 i=0; i<myarrlen(pool->cell_lut); i++)
+			pool->cell_lut[i] = -1;
+	}
+	if (pool->cell_lut[key] < 0) {
+		pool->cell_lut[key] = myarrlen(pool->cells);
+		arrput(pool->cells, cell);
+	}
+
+	/* clipnodes can be shared, so the same leaf may sit behind a different path.
+	 * The cached planes are only usable if they actually contain the point. */
+	const particle_cell_t* const cached = &pool->cells[pool->cell_lut[key]];
+	for (i32 i=0; i<cached->plane_cnt; i++) {
+		const vec4s pl = cached->planes[i];
+		if (pl.x*p.x + pl.y*p.y + pl.z*p.z <= pl.w)
+			return -1;
+	}
+	return pool->cell_lut[key];
+}
+
+/* Gravity and the unclipped end point, 4 particles at a time */
+static void particle_integrate(particle_pool_t* const pool, const float delta) {
+	particle_soa_t* const p = &pool->cur;
+	const i32 cnt = pool->cnt;
+	i32 i = 0;
+#ifdef __SSE2__
+	const __m128 vdelta = _mm_set1_ps(delta);
+	const __m128 vgrav = _mm_set1_ps(PARTICLE_GRAVITY*delta);
+	for (; i+4<=cnt; i+=4) {
+		const __m128 vy = _mm_sub_ps(_mm_load_ps(&p->vy[i]), vgrav);
+		_mm_store_ps(&p->vy[i], vy);
+		_mm_store_ps(&p->ttl[i], _mm_sub_ps(_mm_load_ps(&p->ttl[i]), vdelta));
+		_mm_store_ps(&pool->end_x[i], _mm_add_ps(_mm_load_ps(&p->x[i]), _mm_mul_ps(_mm_load_ps(&p->vx[i]), vdelta)));
+		_mm_store_ps(&pool->end_y[i], _mm_add_ps(_mm_load_ps(&p->y[i]), _mm_mul_ps(vy, vdelta)));
+		_mm_store_ps(&pool->end_z[i], _mm_add_ps(_mm_load_ps(&p->z[i]), _mm_mul_ps(_mm_load_ps(&p->vz[i]), vdelta)));
+	}
+#endif
+	for (; i<cnt; i++) {
+		p->vy[i] -= PARTICLE_GRAVITY*delta;
+		p->ttl[i] -= delta;
+		pool->end_x[i] = p->x[i] + p->vx[i]*delta;
+		pool->end_y[i] = p->y[i] + p->vy[i]*delta;
+		pool->end_z[i] = p->z[i] + p->vz[i]*delta;
+	}
+}
+
+/* Counting sort by cell into the spare buffer, dropping expired particles on the way.
+ * Uncached particles (-1) land at the end, the buffers are swapped afterwards. */
+static void particle_sort(ecs_t* const ecs, particle_pool_t* const pool) {
+	particle_soa_t* const src = &pool->cur;
+	particle_soa_t* const dst = &pool->tmp;
+	const i32 cell_cnt = myarrlen(pool->cells);
+	arrsetlen(pool->cell_cnt, cell_cnt+2);
+	i32* const offset = pool->cell_cnt;
+	memset(offset, 0, (cell_cnt+2)*sizeof(i32));
+
+	for (i32 i=0; i<pool->cnt; i++) {
+		if (src->ttl[i] <= 0 || src->id[i] < 0) {
+			if (src->id[i] >= 0)
+				free_particle(ecs, src->id[i]);
+			src->id[i] = -1;
+			continue;
+		}
+		const i32 c = src->cell[i] < 0 ? cell_cnt : src->cell[i];
+		offset[c+1]++;
+	}
+	for (i32 c=0; c<=cell_cnt; c++)
+		offset[c+1] += offset[c];
+
+	/* the end point becomes the position, the start is still in ecs->pos for the trace fallback */
+	for (i32 i=0; i<pool->cnt; i++) {
+		if (src->id[i] < 0)
+			continue;
+		const i32 c = src->cell[i] < 0 ? cell_cnt : src->cell[i];
+		const i32 o = offset[c]++;
+		dst->x[o] = pool->end_x[i];
+		dst->y[o] = pool->end_y[i];
+		dst->z[o] = pool->end_z[i];
+		dst->vx[o] = src->vx[i];
+		dst->vy[o] = src->vy[i];
+		dst->vz[o] = src->vz[i];
+		dst->ttl[o] = src->ttl[i];
+		dst->id[o] = src->id[i];
+		dst->cell[o] = src->cell[i];
+	}
+	pool->cnt = offset[cell_cnt];
+}
+
+/* Flag every end point that is still inside its particle's cell, one cell's run at a time */
+static void particle_test_cells(particle_pool_t* const pool) {
+	const particle_soa_t* const p = &pool->cur;
+	const i32 cnt = pool->cnt;
+	i32 i = 0;
+	while (i < cnt && p->cell[i] >= 0) {
+		const i32 c = p->cell[i];
+		i32 end = i;
+		while (end < cnt && p->cell[end] == c)
+			end++;
+		const particle_cell_t* const cell = &pool->cells[c];
+#ifdef __SSE2__
+		for (; i+4<=end; i+=4) {
+			const __m128 x = _mm_loadu_ps(&p->x[i]);
+			const __m128 y = _mm_loadu_ps(&p->y[i]);
+			const __m128 z = _mm_loadu_ps(&p->z[i]);
+			__m128 in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (i32 pi=0; pi<cell->plane_cnt; pi++) {
+				const vec4s pl = cell->planes[pi];
+				__m128 d = _mm_mul_ps(x, _mm_set1_ps(pl.x));
+				d = _mm_add_ps(d, _mm_mul_ps(y, _mm_set1_ps(pl.y)));
+				d = _mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(pl.z)));
+				in = _mm_and_ps(in, _mm_cmpgt_ps(d, _mm_set1_ps(pl.w)));
+				if (_mm_movemask_ps(in) == 0)
+					break;
+			}
+			const int mask = _mm_movemask_ps(in);
+			pool->inside[i+0] = mask & 1;
+			pool->inside[i+1] = (mask>>1) & 1;
+			pool->inside[i+2] = (mask>>2) & 1;
+			pool->inside[i+3] = (mask>>3) & 1;
+		}
+#endif
+		for (; i<end; i++) {
+			u8 in = 1;
+			for (i32 pi=0; pi<cell->plane_cnt && in; pi++) {
+				const vec4s pl = cell->planes[pi];
+				in = pl.x*p->x[i] + pl.y*p->y[i] + pl.z*p->z[i] > pl.w;
+			}
+			pool->inside[i] = in;
+		}
+	}
+	for (; i<cnt; i++)
+		pool->inside[i] = 0;
+}
+
 void particle_update(engine_t *e, const float delta) {
 	ecs_t* const ecs = &e->ecs;
+	particle_pool_t* const pool = &ecs->particles;
+	const hull_t* const hull = &e->assets.map.qmods[0].hulls[0];
 
 	/* Update Particles */
-	for (i32 i=0; i<myarrlen(ecs->flags); i++) {
-		const flag_t flags = ecs->flags[i];
-		if (bitarr_get(ecs->bit_particle, i)) {
-			/* Cooldown and Cull */
-			ecs->cooldown0[i] -= delta;
-			if (ecs->cooldown0[i] <= 0) {
-				free_particle(ecs, i);
-				continue;
-			}
+	particle_integrate(pool, delta);
+	particle_sort(ecs, pool);
+	{
+		particle_soa_t tmp = pool->cur;
+		pool->cur = pool->tmp;
+		pool->tmp = tmp;
+	}
+	particle_test_cells(pool);
 
+	particle_soa_t* const p = &pool->cur;
+	const float drag = 1.0f - MIN(PARTICLE_DRAG*delta, 1.0f);
+	for (i32 i=0; i<pool->cnt; i++) {
+		if (pool->inside[i]) {
+			/* never left its empty cell, so there is nothing to hit */
+			p->vx[i] *= drag;
+			p->vy[i] *= drag;
+			p->vz[i] *= drag;
+		} else {
 			bbox_t move;
-			vec3s pos = ecs->pos[i];
-			move.min = pos;
-			vec3s vel = ecs->vel[i];
-
-			vel.y -= PARTICLE_GRAVITY * delta;
-			glm_vec3_scale(vel.raw, delta, move.max.raw);
-			glm_vec3_add(move.min.raw, move.max.raw, move.max.raw);
+			move.max = (vec3s){{p->x[i], p->y[i], p->z[i]}};
+			move.min = ecs->pos[p->id[i]];
 			trace_t trace = {0};
 			trace.endpos = move.max;
-			SV_RecursiveHullCheck(&e->assets.map.qmods[0].hulls[0], &move, &trace, CONTENTMASK_ANYSOLID);
+			SV_RecursiveHullCheck(hull, &move, &trace, CONTENTMASK_ANYSOLID);
 			if (!trace.inopen) {
-				/* myprintf("traceopen c:%d %.2f %.2fx%.2fx%.2f\n", trace.contents, trace.fraction, trace.endpos.x, trace.endpos.y, trace.endpos.z); */
-				free_particle(&e->ecs, i);
+				free_particle(ecs, p->id[i]);
+				p->id[i] = -1;
 				continue;
 			} else if (trace.contents != -1) {
-				/* myprintf("trace c:%d %.2f %.2fx%.2fx%.2f\n", trace.contents, trace.fraction, trace.endpos.x, trace.endpos.y, trace.endpos.z); */
-				ecs->pos[i] = trace.endpos;
-				ecs->vel[i] = (vec3s){{0,0,0}};
+				p->vx[i] = p->vy[i] = p->vz[i] = 0;
+				p->cell[i] = -1;
 			} else {
-				/* myprintf("trace d:%.2f c:%d %.2f %.2fx%.2fx%.2f\n", delta, trace.contents, trace.fraction, trace.endpos.x, trace.endpos.y, trace.endpos.z); */
-				ecs->pos[i] = trace.endpos;
-				vec3s vel2;
-				glm_vec3_scale(vel.raw, MIN(PARTICLE_DRAG*delta, 1.0f), vel2.raw);
-				glm_vec3_sub(vel.raw, vel2.raw, vel.raw);
-				ecs->vel[i] = vel;
+				p->vx[i] *= drag;
+				p->vy[i] *= drag;
+				p->vz[i] *= drag;
+				p->cell[i] = particle_find_cell(pool, hull, trace.endpos);
 			}
-		} else if (flags.decay) {
+			p->x[i] = trace.endpos.x;
+			p->y[i] = trace.endpos.y;
+			p->z[i] = trace.endpos.z;
+		}
+		ecs->pos[p->id[i]] = (vec3s){{p->x[i], p->y[i], p->z[i]}};
+	}
+
+	/* Beams */
+	SPARSE_EACH(&ecs->set_model, i) {
+		if (ecs->flags[i].decay) {
 			ecs->cooldown0[i] -= delta;
 			if (ecs->cooldown0[i] <= 0) {
 				free_beam(ecs, i);
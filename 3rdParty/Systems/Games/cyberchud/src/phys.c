@@ -60,7 +60,7 @@ void SV_PushMove(engine_t* const e, edict_t* const pusher, const float movetime)
 	/* see if any solid entities are inside the final position */
 	int num_moved = 0;
 	/* check = NEXT_EDICT(qcvm->edicts); */
-	for (i32 i=0; i<myarrlen(ecs->flags); i++) {
+	SPARSE_EACH(&ecs->set_edict, i) {
 		const flag_t flags = ecs->flags[i];
 		if (!flags.mob)
 			continue;
@@ -148,8 +148,11 @@ void SV_PushMove(engine_t* const e, edict_t* const pusher, const float movetime)
 void update_edicts(engine_t* const e, const float delta) {
 	ecs_t* const ecs = &e->ecs;
 	#define DRAG_COEFFICIENT 0.1
-	const i32 ent_cnt = myarrlen(ecs->flags);
-	for (i32 i=0; i<ent_cnt; i++) {
+	/* think/touch can spawn and free edicts, walk a copy and skip the ones that died,
+	 * not SPARSE_EACH since SV_PushMove walks set_edict itself */
+	const i32 ent_cnt = sparse_copy(&ecs->set_edict, &ecs->iter_buf);
+	for (i32 ei=0; ei<ent_cnt; ei++) {
+		const i32 i = ecs->iter_buf[ei];
 		if (bitarr_get(ecs->bit_edict, i)) {
 			vec3s vel = ecs->vel[i];
 			const vec3s pos = ecs->pos[i];
@@ -0,0 +1,96 @@
+#include <string.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "planar.h"
+
+#define CHUNK_PX 16
+#define CHUNK_CNT (VGA_W/CHUNK_PX)
+
+void vga_planar_init(vga_planar_t* const vp) {
+	/* pixels are 0-15, so 0xff forces every row dirty on the first present */
+	memset(vp->fb_cache, 0xff, sizeof(vp->fb_cache));
+	memset(vp->planes, 0, sizeof(vp->planes));
+	memset(vp->spans, 0, sizeof(vp->spans));
+	vp->dirty_cnt = 0;
+}
+
+/* Chunky to planar for plane bytes [x1,x2) of one row, leftmost pixel goes in the MSB.
+ * x1 and x2 must be even, which dirty tracking guarantees by working in 16 pixel chunks. */
+void c2p_row(const uint8_t* const src, uint8_t* const dst, const size_t plane_stride, const int x1, const int x2) {
+#ifdef __SSSE3__
+	/* reverse each group of 8 so PMOVMSKB puts the leftmost pixel in bit 7 */
+	const __m128i rev = _mm_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+	for (int x=x1; x<x2; x+=2) {
+		const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&src[x*8]), rev);
+		/* shifting 16bit lanes is fine, bit 7 of each byte only ever comes from its own byte */
+		const uint16_t m0 = _mm_movemask_epi8(_mm_slli_epi16(v, 7));
+		const uint16_t m1 = _mm_movemask_epi8(_mm_slli_epi16(v, 6));
+		const uint16_t m2 = _mm_movemask_epi8(_mm_slli_epi16(v, 5));
+		const uint16_t m3 = _mm_movemask_epi8(_mm_slli_epi16(v, 4));
+		memcpy(&dst[x], &m0, 2);
+		memcpy(&dst[plane_stride+x], &m1, 2);
+		memcpy(&dst[plane_stride*2+x], &m2, 2);
+		memcpy(&dst[plane_stride*3+x], &m3, 2);
+	}
+#else
+	/* gather bit 0 of 8 bytes into one byte with a multiply, byte 0 lands in bit 7 */
+	for (int x=x1; x<x2; x++) {
+		uint64_t v;
+		memcpy(&v, &src[x*8], 8);
+		for (int plane=0; plane<VGA_PLANE_CNT; plane++) {
+			const uint64_t bits = (v>>plane) & 0x0101010101010101ull;
+			dst[plane_stride*plane+x] = (bits*0x8040201008040201ull)>>56;
+		}
+	}
+#endif
+}
+
+static inline int chunk_differs(const uint8_t* const a, const uint8_t* const b) {
+#ifdef __SSE2__
+	const __m128i va = _mm_loadu_si128((const __m128i*)a);
+	const __m128i vb = _mm_loadu_si128((const __m128i*)b);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xffff;
+#else
+	uint64_t a0, a1, b0, b1;
+	memcpy(&a0, a, 8);
+	memcpy(&a1, a+8, 8);
+	memcpy(&b0, b, 8);
+	memcpy(&b1, b+8, 8);
+	return ((a0^b0)|(a1^b1)) != 0;
+#endif
+}
+
+/* Diff the rows this present will upload against what the card holds,
+ * convert only the changed spans and record them for the upload pass. */
+uint32_t vga_planar_update(vga_planar_t* const vp, const uint8_t* const fb, const int interlace) {
+	vp->dirty_cnt = 0;
+	for (int y=(interlace&1); y<VGA_H; y+=2) {
+		const uint8_t* const row = &fb[y*VGA_W];
+		uint8_t* const cache = &vp->fb_cache[y*VGA_W];
+
+		int first = -1;
+		int last = -1;
+		for (int c=0; c<CHUNK_CNT; c++) {
+			if (chunk_differs(&row[c*CHUNK_PX], &cache[c*CHUNK_PX])) {
+				if (first < 0)
+					first = c;
+				last = c;
+			}
+		}
+		if (first < 0)
+			continue;
+
+		const int x1 = first*CHUNK_PX/8;
+		const int x2 = (last+1)*CHUNK_PX/8;
+		memcpy(&cache[x1*8], &row[x1*8], (x2-x1)*8);
+		c2p_row(row, &vp->planes[0][y*VGA_ROW_BYTES], VGA_PLANE_BYTES, x1, x2);
+		vp->spans[y].x1 = x1;
+		vp->spans[y].x2 = x2;
+		vp->dirty_rows[vp->dirty_cnt++] = y;
+	}
+	return vp->dirty_cnt;
+}
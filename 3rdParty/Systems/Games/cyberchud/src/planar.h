@@ -0,0 +1,31 @@
+#ifndef PLANAR_H
+#define PLANAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* 640x480 16 color VGA, 4 bitplanes of 1bpp */
+#define VGA_W 640
+#define VGA_H 480
+#define VGA_PLANE_CNT 4
+#define VGA_ROW_BYTES (VGA_W/8)
+#define VGA_PLANE_BYTES (VGA_ROW_BYTES*VGA_H)
+
+typedef struct {
+	uint8_t x1; // first dirty byte in the plane row
+	uint8_t x2; // one past the last dirty byte
+} vga_span_t;
+
+typedef struct {
+	uint8_t fb_cache[VGA_W*VGA_H]; // what the card currently shows
+	uint8_t planes[VGA_PLANE_CNT][VGA_PLANE_BYTES];
+	vga_span_t spans[VGA_H];
+	uint16_t dirty_rows[VGA_H];
+	uint32_t dirty_cnt;
+} vga_planar_t;
+
+void vga_planar_init(vga_planar_t* const vp);
+void c2p_row(const uint8_t* const src, uint8_t* const dst, const size_t plane_stride, const int x1, const int x2);
+uint32_t vga_planar_update(vga_planar_t* const vp, const uint8_t* const fb, const int interlace);
+
+#endif
@@ -186,21 +186,9 @@ void playfield_update(engine_t* const e, const float delta) {
 	/* update edicts */
 	{
 		const TIME_TYPE start = get_time();
-		const i32 ent_cnt = myarrlen(ecs->flags);
-		for (i32 i=0; i<ent_cnt; i++) {
-			if (bitarr_get(ecs->bit_edict, i)) {
-				/* TODO optimize? */
-				glm_vec3_add(ecs->pos[i].raw, ecs->bbox[i].min.raw, ecs->edict[i].edict->absbox.min.raw);
-				glm_vec3_add(ecs->pos[i].raw, ecs->bbox[i].max.raw, ecs->edict[i].edict->absbox.max.raw);
-
-				if (ecs->edict[i].edict->solid == SOLID_SLIDEBOX) {
-					/* myprintf("=trigger %d=\n", i); */
-					/* print_vec3("XXZentmin", ecs->edict[i].absbox.min); */
-					/* print_vec3("XXZentmax", ecs->edict[i].absbox.max); */
-					/* print_vec3("XXZentmin", ecs->bbox[i].min); */
-					/* print_vec3("XXZentmax", ecs->bbox[i].max); */
-				}
-			}
+		SPARSE_EACH(&ecs->set_edict, i) {
+			glm_vec3_add(ecs->pos[i].raw, ecs->bbox[i].min.raw, ecs->edict[i].edict->absbox.min.raw);
+			glm_vec3_add(ecs->pos[i].raw, ecs->bbox[i].max.raw, ecs->edict[i].edict->absbox.max.raw);
 		}
 		e->time_absbox = time_diff(start, get_time())*1000;
 	}
@@ -22,6 +22,9 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include <assert.h>
 #include <float.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "quake.h"
 #include "text.h"
@@ -44,6 +47,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #define DIST_EPSILON (0.03125/BSP_RESIZE_DIV) // 1/32 epsilon to keep floating point happy
 #define MIN(a,b) (((a)<(b))?(a):(b))
+#define MAX(a,b) (((a)>(b))?(a):(b))
 
 #define DoublePrecisionDotProduct(a,b) ((double)(a).x*(b).x+(double)(a).y*(b).y+(double)(a).z*(b).z)
 
@@ -403,15 +407,87 @@ Mins and maxs enclose the entire area swept by the move
 #define EDICT_FROM_AREA(l) STRUCT_FROM_LINK (l, edict_t, basic.area)
 #define EDICT_TO_PROG(e) ((uint8_t*)e - (uint8_t*)e->qcvm.edicts)
 #define PROG_TO_EDICT(e) ((edict_t*)((uint8_t*)e->qcvm.edicts + e))
-static void SV_ClipToLinks(engine_t *e, areanode_t *node, moveclip_t *clip) {
-	link_t *l, *next;
+static inline int32_t area_axis_cell(const area_grid_t* const grid, const float v, const float origin, const int32_t cnt) {
+	const float f = (v-origin)/grid->cell_size;
+	if (!(f >= 0))
+		return 0;
+	return f >= cnt ? cnt-1 : (int32_t)f;
+}
+
+static inline area_box_t area_box(const bbox_t* const box) {
+	return (area_box_t){
+		.min = {{box->min.x, box->min.y, box->min.z, 0}},
+		.max = {{box->max.x, box->max.y, box->max.z, 0}},
+	};
+}
+
+static inline int area_box_overlap(const area_box_t* const a, const area_box_t* const b) {
+#ifdef __SSE2__
+	const __m128 out = _mm_or_ps(_mm_cmpgt_ps(_mm_loadu_ps(a->min.raw), _mm_loadu_ps(b->max.raw)),
+		_mm_cmplt_ps(_mm_loadu_ps(a->max.raw), _mm_loadu_ps(b->min.raw)));
+	return _mm_movemask_ps(out) == 0;
+#else
+	return !(a->min.x > b->max.x || a->min.y > b->max.y || a->min.z > b->max.z ||
+		a->max.x < b->min.x || a->max.y < b->min.y || a->max.z < b->min.z);
+#endif
+}
+
+/* Cells a box can touch, an edict's box spills at most half a cell past the cell holding its center */
+static void area_range(const area_grid_t* const grid, const bbox_t* const box, int32_t range[4]) {
+	const float half = 0.5f*grid->cell_size;
+	range[0] = area_axis_cell(grid, box->min.x-half, grid->origin_x, grid->w);
+	range[1] = area_axis_cell(grid, box->max.x+half, grid->origin_x, grid->w);
+	range[2] = area_axis_cell(grid, box->min.z-half, grid->origin_z, grid->h);
+	range[3] = area_axis_cell(grid, box->max.z+half, grid->origin_z, grid->h);
+}
+
+static area_list_t* area_list_for(area_grid_t* const grid, const edict_t* const ent) {
+	const bbox_t* const box = &ent->absbox;
+	int32_t cell = grid->w*grid->h;
+	if (box->max.x-box->min.x <= grid->cell_size && box->max.z-box->min.z <= grid->cell_size) {
+		const int32_t x = area_axis_cell(grid, 0.5f*(box->min.x+box->max.x), grid->origin_x, grid->w);
+		const int32_t z = area_axis_cell(grid, 0.5f*(box->min.z+box->max.z), grid->origin_z, grid->h);
+		cell = z*grid->w + x;
+	}
+	return &grid->lists[cell*2 + (ent->solid == SOLID_TRIGGER)];
+}
+
+/* swap with the last entry so the lists stay packed */
+static void area_list_remove(edict_t* const ent) {
+	area_list_t* const list = ent->area_list;
+	const int32_t last = myarrlen(list->ents)-1;
+	if (ent->area_idx != last) {
+		list->boxes[ent->area_idx] = list->boxes[last];
+		list->ents[ent->area_idx] = list->ents[last];
+		list->ents[ent->area_idx]->area_idx = ent->area_idx;
+	}
+	arrsetlen(list->boxes, last);
+	arrsetlen(list->ents, last);
+	ent->area_list = NULL;
+}
+
+static void area_list_add(area_list_t* const list, edict_t* const ent) {
+	/* myarrlen needs a header */
+	if (list->ents == NULL) {
+		arrsetcap(list->boxes, 16);
+		arrsetcap(list->ents, 16);
+	}
+	ent->area_list = list;
+	ent->area_idx = myarrlen(list->ents);
+	arrput(list->boxes, area_box(&ent->absbox));
+	arrput(list->ents, ent);
+}
+
+static void SV_ClipToList(engine_t *e, const area_list_t* const list, const area_box_t* const box, moveclip_t *clip) {
 	edict_t *touch;
 	trace_t trace;
 
-	// touch linked edicts
-	for (l = node->solid_edicts.next; l != &node->solid_edicts; l = next) {
-		next = l->next;
-		touch = EDICT_FROM_AREA(l);
+	// touch linked edicts, lists nothing was linked into yet have no array
+	const i32 cnt = list->ents ? myarrlen(list->ents) : 0;
+	for (i32 i=0; i<cnt; i++) {
+		if (!area_box_overlap(box, &list->boxes[i]))
+			continue;
+		touch = list->ents[i];
 		if (touch->solid == SOLID_NOT)
 			continue;
 		if (touch->basic.id >= 0 && touch->basic.id == clip->id)
@@ -479,15 +555,21 @@ static void SV_ClipToLinks(engine_t *e, areanode_t *node, moveclip_t *clip) {
 			clip->trace.startsolid = true;
 		}
 	}
+}
 
-	// recurse down both sides
-	if (node->axis == -1)
-		return;
-
-	if (clip->box.max.raw[node->axis] > node->dist)
-		SV_ClipToLinks(e, node->children[0], clip);
-	if (clip->box.min.raw[node->axis] < node->dist)
-		SV_ClipToLinks(e, node->children[1], clip);
+static void SV_ClipToLinks(engine_t *e, moveclip_t *clip) {
+	const area_grid_t* const grid = &e->ecs.qcvm.area;
+	const area_box_t box = area_box(&clip->box);
+	int32_t range[4];
+	area_range(grid, &clip->box, range);
+	for (int32_t z=range[2]; z<=range[3]; z++) {
+		for (int32_t x=range[0]; x<=range[1]; x++) {
+			SV_ClipToList(e, &grid->lists[(z*grid->w + x)*2], &box, clip);
+			if (clip->trace.allsolid)
+				return;
+		}
+	}
+	SV_ClipToList(e, &grid->lists[grid->w*grid->h*2], &box, clip);
 }
 
 static void SV_MoveBounds(const bbox_t* const move, const bbox_t* const size, bbox_t *out) {
@@ -538,7 +620,7 @@ trace_t SV_Move(engine_t *e, const int32_t id, bbox_t *move, int type) {
 	SV_MoveBounds(move, &clip.size2, &clip.box);
 
 	/* clip to entities */
-	SV_ClipToLinks(e, e->ecs.qcvm.areanodes, &clip);
+	SV_ClipToLinks(e, &clip);
 
 	return clip.trace;
 }
@@ -931,10 +1013,9 @@ static void InsertLinkBefore(link_t *l, link_t *before) {
 }
 
 void SV_UnlinkEdict(edict_t *ent) {
-	if (!ent->basic.area.prev)
+	if (!ent->area_list)
 		return; // not linked in anywhere
-	RemoveLink(&ent->basic.area);
-	ent->basic.area.prev = ent->basic.area.next = NULL;
+	area_list_remove(ent);
 }
 
 #if 0
@@ -1121,26 +1202,20 @@ static void SV_FindTouchedLeafs(engine_t *e, edict_t* const ent, const bsp_mnode
 		SV_FindTouchedLeafs(e, ent, node->children[1]);
 }
 
-static void SV_AreaTriggerEdicts(edict_t *ent, areanode_t *node, edict_t **list, int *listcount) {
-	link_t *l, *next;
+static void SV_AreaTriggerList(edict_t *ent, const area_box_t* const box, const area_list_t* const area, edict_t **list, int *listcount) {
 	edict_t *touch;
 
-	// touch linked edicts
-	for (l=node->trigger_edicts.next; l!=&node->trigger_edicts; l=next) {
-		next = l->next;
-		touch = EDICT_FROM_AREA(l);
+	// touch linked edicts, lists nothing was linked into yet have no array
+	const i32 cnt = area->ents ? myarrlen(area->ents) : 0;
+	for (i32 i=0; i<cnt; i++) {
+		if (!area_box_overlap(box, &area->boxes[i]))
+			continue;
+		touch = area->ents[i];
 		if (touch == ent) {
 			continue;
 		} else if (!touch->touch || touch->solid != SOLID_TRIGGER) {
 			continue;
 		}
-		if (touch->solid == SOLID_SLIDEBOX) {
-			print_vec3("XXentmin", ent->absbox.min);
-			print_vec3("XXentmax", ent->absbox.max);
-			print_vec3("XXtouchmin", touch->absbox.min);
-			print_vec3("XXtouchmax", touch->absbox.max);
-			myprintf("XX:%d %d\n", touch->basic.id, touch->solid);
-		}
 
 		if (ent->absbox.min.x > touch->absbox.max.x || ent->absbox.min.y > touch->absbox.max.y ||
 			 ent->absbox.min.z > touch->absbox.max.z || ent->absbox.max.x < touch->absbox.min.x ||
@@ -1150,15 +1225,17 @@ static void SV_AreaTriggerEdicts(edict_t *ent, areanode_t *node, edict_t **list,
 		list[*listcount] = touch;
 		(*listcount)++;
 	}
+}
 
-	// recurse down both sides
-	if (node->axis == -1)
-		return;
-
-	if (ent->absbox.max.raw[node->axis] > node->dist)
-		SV_AreaTriggerEdicts(ent, node->children[0], list, listcount);
-	if (ent->absbox.min.raw[node->axis] < node->dist)
-		SV_AreaTriggerEdicts(ent, node->children[1], list, listcount);
+static void SV_AreaTriggerEdicts(const area_grid_t* const grid, edict_t *ent, edict_t **list, int *listcount) {
+	const area_box_t box = area_box(&ent->absbox);
+	int32_t range[4];
+	area_range(grid, &ent->absbox, range);
+	for (int32_t z=range[2]; z<=range[3]; z++) {
+		for (int32_t x=range[0]; x<=range[1]; x++)
+			SV_AreaTriggerList(ent, &box, &grid->lists[(z*grid->w + x)*2 + 1], list, listcount);
+	}
+	SV_AreaTriggerList(ent, &box, &grid->lists[grid->w*grid->h*2 + 1], list, listcount);
 }
 
 /*
@@ -1176,7 +1253,7 @@ static void SV_TouchLinks(engine_t* const e, edict_t* const ent) {
 	arrsetlen(list, e->ecs.qcvm.edict_cnt);
 
 	int listcount = 0;
-	SV_AreaTriggerEdicts(ent, e->ecs.qcvm.areanodes, list, &listcount);
+	SV_AreaTriggerEdicts(&e->ecs.qcvm.area, ent, list, &listcount);
 
 	for (int i=0; i<listcount; i++) {
 		edict_t *touch = list[i];
@@ -1194,11 +1271,6 @@ static void SV_TouchLinks(engine_t* const e, edict_t* const ent) {
 }
 
 void SV_LinkEdict(engine_t* e, edict_t *ent, bool touch_triggers) {
-	areanode_t *node;
-
-	if (ent->basic.area.prev)
-		SV_UnlinkEdict(ent); // unlink from old position
-
 	/* needed? */
 	/* if (ent == qcvm->edicts) */
 	/* 	return; // don't add the world */
@@ -1259,27 +1331,19 @@ void SV_LinkEdict(engine_t* e, edict_t *ent, bool touch_triggers) {
 	const bsp_qmodel_t* const worldmodel = &e->assets.map.qmods[0];
 	SV_FindTouchedLeafs(e, ent, worldmodel->nodes);
 
-	if (ent->solid == SOLID_NOT)
+	if (ent->solid == SOLID_NOT) {
+		SV_UnlinkEdict(ent);
 		return;
-
-	/* find the first node that the ent's box crosses */
-	node = e->ecs.qcvm.areanodes;
-	while (1) {
-		if (node->axis == -1)
-			break;
-		if (ent->absbox.min.raw[node->axis] > node->dist)
-			node = node->children[0];
-		else if (ent->absbox.max.raw[node->axis] < node->dist)
-			node = node->children[1];
-		else
-			break; // crosses the node
 	}
 
-	/* link it in */
-	if (ent->solid == SOLID_TRIGGER)
-		InsertLinkBefore(&ent->basic.area, &node->trigger_edicts);
-	else
-		InsertLinkBefore(&ent->basic.area, &node->solid_edicts);
+	/* only moves between lists when it changes cell, otherwise the box is updated in place */
+	area_list_t* const list = area_list_for(&e->ecs.qcvm.area, ent);
+	if (ent->area_list == list) {
+		list->boxes[ent->area_idx] = area_box(&ent->absbox);
+	} else {
+		SV_UnlinkEdict(ent); // unlink from old position
+		area_list_add(list, ent);
+	}
 
 	/* if touch_triggers, touch all entities at this node and decend for more */
 	if (touch_triggers)
@@ -1418,41 +1482,45 @@ void SV_WalkMove(engine_t *e, const int32_t id, const float delta) {
 	}
 }
 
-areanode_t *SV_CreateAreaNode(qcvm_t* qcvm, int depth, const vec3 mins, const vec3 maxs) {
-	areanode_t *anode;
-	vec3 size;
-	vec3 mins1, maxs1, mins2, maxs2;
-
-	anode = &qcvm->areanodes[qcvm->numareanodes];
-	qcvm->numareanodes++;
-
-	ClearLink(&anode->trigger_edicts);
-	ClearLink(&anode->solid_edicts);
-
-	glm_vec3_sub((float*)maxs, (float*)mins, size);
-	if (size[0] > size[2])
-		anode->axis = 0;
-	else
-		anode->axis = 1;
-
-	if (depth == MAX_AREA_DEPTH || size[anode->axis] < 500/BSP_RESIZE_DIV) {
-		anode->axis = -1;
-		anode->children[0] = anode->children[1] = NULL;
-		return anode;
+/* Sizes the broadphase grid to the world model, every edict was unlinked by ecs_reset */
+static void SV_CreateAreaGrid(area_grid_t* const grid, const bbox_t* const bounds) {
+	const float size_x = bounds->max.x - bounds->min.x;
+	const float size_z = bounds->max.z - bounds->min.z;
+	grid->cell_size = MAX(AREA_CELL_SIZE, MAX(size_x, size_z)/AREA_GRID_MAX);
+	grid->origin_x = bounds->min.x;
+	grid->origin_z = bounds->min.z;
+	grid->w = MAX(1, (int32_t)ceilf(size_x/grid->cell_size));
+	grid->h = MAX(1, (int32_t)ceilf(size_z/grid->cell_size));
+
+	const i32 list_cnt = (grid->w*grid->h + 1)*2;
+	const i32 old_cnt = grid->lists ? myarrlen(grid->lists) : 0;
+	for (i32 i=list_cnt; i<old_cnt; i++) {
+		arrfree(grid->lists[i].boxes);
+		arrfree(grid->lists[i].ents);
 	}
+	arrsetlen(grid->lists, list_cnt);
+	for (i32 i=0; i<list_cnt; i++) {
+		area_list_t* const list = &grid->lists[i];
+		if (i >= old_cnt) {
+			*list = (area_list_t){0};
+		} else if (list->ents) {
+			arrsetlen(list->boxes, 0);
+			arrsetlen(list->ents, 0);
+		}
+	}
+#ifndef NDEBUG
+	myprintf("[SV_CreateAreaGrid] %dx%d cell_size:%.2f\n", grid->w, grid->h, grid->cell_size);
+#endif
+}
 
-	anode->dist = 0.5 * (maxs[anode->axis] + mins[anode->axis]);
-	glm_vec3_copy((float*)mins, mins1);
-	glm_vec3_copy((float*)mins, mins2);
-	glm_vec3_copy((float*)maxs, maxs1);
-	glm_vec3_copy((float*)maxs, maxs2);
-
-	maxs1[anode->axis] = mins2[anode->axis] = anode->dist;
-
-	anode->children[0] = SV_CreateAreaNode(qcvm, depth + 1, mins2, maxs2);
-	anode->children[1] = SV_CreateAreaNode(qcvm, depth + 1, mins1, maxs1);
-
-	return anode;
+void SV_FreeAreaGrid(area_grid_t* const grid) {
+	if (grid->lists == NULL)
+		return;
+	for (i32 i=0; i<myarrlen(grid->lists); i++) {
+		arrfree(grid->lists[i].boxes);
+		arrfree(grid->lists[i].ents);
+	}
+	arrfree(grid->lists);
 }
 
 void SV_ClearWorld(engine_t *e) {
@@ -1479,9 +1547,8 @@ void SV_ClearWorld(engine_t *e) {
 
 	SV_InitBoxHull(&e->hb);
 
-	ecs->qcvm.numareanodes = 0;
-	memset(ecs->qcvm.areanodes, 0, sizeof(areanode_t)*AREA_NODES);
-	SV_CreateAreaNode(&ecs->qcvm, 0, e->assets.map.qmods[0].bbox.min.raw, e->assets.map.qmods[0].bbox.max.raw);
+	SV_CreateAreaGrid(&ecs->qcvm.area, &e->assets.map.qmods[0].bbox);
+	light_probes_reset(&e->probes, &e->assets.map);
 
 	for (u32 i=0; i<e->assets.map.leaf_cnt; i++) {
 		bsp_mleaf_t* const leaf = &e->assets.map.leafs[i];
@@ -1761,7 +1828,7 @@ void TraceLine(engine_t *e, const hull_t* hull, const bbox_t* const move, trace_
 	SV_MoveBounds(&clip.move, &clip.size, &clip.box);
 
 	/* clip to entities */
-	SV_ClipToLinks(e, e->ecs.qcvm.areanodes, &clip);
+	SV_ClipToLinks(e, &clip);
 	*trace = clip.trace;
 	/* myprintf("trace: ent:%d\n", trace->ent); */
 }
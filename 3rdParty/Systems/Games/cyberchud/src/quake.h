@@ -85,6 +85,7 @@ void SV_LinkLightDynamic(engine_t* e, edict_light_t *ent);
 
 void SV_UserFriction(engine_t* e, const i32 id, const f32 delta);
 void SV_ClearWorld(engine_t *e);
+void SV_FreeAreaGrid(area_grid_t* const grid);
 trace_t SV_PushEntity(engine_t* const e, const int32_t id, const vec3s push);
 bool SV_StepDirection(engine_t* const e, edict_t *ent, const vec3s dir, const float dist, const float delta);
 void SV_Accelerate(ecs_t* const ecs, const i32 id, const float wishspeed, const vec3s wishdir, const float delta);
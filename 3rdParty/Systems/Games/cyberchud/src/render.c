@@ -120,6 +120,12 @@ static inline void mat4_init_pos(vec3 pos, mat4s* dest) {
 	}};
 }
 
+static inline float timed_job(engine_threads_t* const et, const JOB_STATE state) {
+	const TIME_TYPE start = get_time();
+	thread_set_and_go(et, state);
+	return time_diff(start, get_time())*1000;
+}
+
 void render(engine_threads_t *et, const float delta) {
 #ifdef VERBOSE
 	myprintf("[render]\n");
@@ -174,19 +180,20 @@ void render(engine_threads_t *et, const float delta) {
 	e->screen_pulse_time += delta;
 	if (e->screen_pulse_time > 1.0f)
 		e->vfx_flags.screen_pulse = 0;
+	const float pulse = e->vfx_flags.screen_pulse ? fmodf(e->screen_pulse_time*2, 1.0f) : 0;
+	if (e->quant.step_cnt == 0 || pulse != e->quant.pulse)
+		palette_quant_build(&e->quant, pulse);
 
 	/* Generate Model Matrix */
-	const i32 elen = myarrlen(ecs->flags);
-	for (i32 i=0; i<elen; i++) {
-		if (ecs->flags[i].model_mtx) {
-			ecs->mtx[i] = glms_mat4_identity();
-			glm_scale(ecs->mtx[i].raw, ecs->scale[i].raw);
-			glm_quat_rotate(ecs->mtx[i].raw, ecs->rot[i].raw, ecs->mtx[i].raw);
-			mat4s tmat;
-			mat4_init_pos(ecs->pos[i].raw, &tmat);
-			glm_mat4_mul(tmat.raw, ecs->mtx[i].raw, ecs->mtx[i].raw);
-		}
+	SPARSE_EACH(&ecs->set_model, i) {
+		ecs->mtx[i] = glms_mat4_identity();
+		glm_scale(ecs->mtx[i].raw, ecs->scale[i].raw);
+		glm_quat_rotate(ecs->mtx[i].raw, ecs->rot[i].raw, ecs->mtx[i].raw);
+		mat4s tmat;
+		mat4_init_pos(ecs->pos[i].raw, &tmat);
+		glm_mat4_mul(tmat.raw, ecs->mtx[i].raw, ecs->mtx[i].raw);
 	}
+	const i32 elen = myarrlen(ecs->flags);
 
 	/* Link Lights */
 	/* TODO optimize */
@@ -504,14 +511,23 @@ void render(engine_threads_t *et, const float delta) {
 	}
 
 	/* Frustum Cull Models */
+	e->time_bones = e->time_verts = e->time_shadow = e->time_frag = 0;
 	job_frustum_cull(e);
 
-	/* Filter Culled for Bones */
+	/* Filter Culled for Bones
+	 * Far models keep their last skinned pose for a few frames, the skipped time is caught up on the next pose */
 	const int32_t max_threads = e->cpu_cnt;
 	arrsetlen(e->idxs_bones, 0);
+	e->anim_frame++;
 	for (size_t i=0; i<myarrlenu(e->idxs_culled); i++) {
 		const size_t idx = e->idxs_culled[i];
-		if (ecs->flags[idx].bones)
+		if (!ecs->flags[idx].bones)
+			continue;
+		anim_t* const anim = &ecs->anim[idx];
+		anim->lod_delta += delta;
+		const float dist2 = glms_vec3_distance2(ecs->pos[idx], e->cam.pos);
+		const u32 interval = dist2 > ANIM_LOD_FAR*ANIM_LOD_FAR ? 4 : dist2 > ANIM_LOD_NEAR*ANIM_LOD_NEAR ? 2 : 1;
+		if (!anim->skinned || (e->anim_frame+idx) % interval == 0)
 			arrput(e->idxs_bones, idx);
 	}
 
@@ -526,7 +542,7 @@ void render(engine_threads_t *et, const float delta) {
 			et->jobs[i].entities = e->idxs_bones+i*div_cnt;
 		}
 		et->jobs[max_threads-1].cnt += leftover;
-		thread_set_and_go(et, JOB_STATE_BONES);
+		e->time_bones = timed_job(et, JOB_STATE_BONES);
 	}
 
 	/* Verts */
@@ -582,7 +598,13 @@ void render(engine_threads_t *et, const float delta) {
 			}
 		}
 	}
-	thread_set_and_go(et, JOB_STATE_VERTS);
+	if (!e->probes.ready && e->probes.light) {
+		const float probe_ms = timed_job(et, JOB_STATE_PROBES);
+		e->probes.ready = 1;
+		myprintf("[render] light probes %dx%dx%d baked in %.2fms\n", e->probes.w, e->probes.h, e->probes.d, probe_ms);
+		light_probes_validate(&e->probes, &e->assets.map);
+	}
+	e->time_verts = timed_job(et, JOB_STATE_VERTS);
 
 	if (!e->vfx_flags.wireframe && !e->vfx_flags.skip_frag) {
 		/* Shadow Job */
@@ -590,16 +612,35 @@ void render(engine_threads_t *et, const float delta) {
 			for (i32 ii=0; ii<max_threads; ii++)
 				et->jobs[i].frag_in_data[ii] = et->jobs[ii].vert_out_data;
 		}
-		thread_set_and_go(et, JOB_STATE_SHADOW);
+
+		/* Find Cubemap Faces With Dynamic Casters */
+		for (int i=0; i<e->pointlights.cnt; i++) {
+			cubemap_t* const cubemap = &e->pointlights.cubemaps[i];
+			cubemap->dynamic_faces = 0;
+			for (i32 ti=0; ti<max_threads; ti++)
+				cubemap->dynamic_faces |= cubemap_face_mask(&et->jobs[ti].vert_out_data.pointlight_model[i]);
+		}
+		for (int i=0; i<e->shadowcasters.cnt; i++) {
+			cubemap_t* const cubemap = &e->shadowcasters.cubemaps[i].basic;
+			cubemap->dynamic_faces = 0;
+			for (i32 ti=0; ti<max_threads; ti++)
+				cubemap->dynamic_faces |= cubemap_face_mask(&et->jobs[ti].vert_out_data.shadow_model[i]);
+		}
+
+		e->time_shadow = timed_job(et, JOB_STATE_SHADOW);
 
 		/* Mark Cubemaps as Clean */
-		for (int i=0; i<e->pointlights.cnt; i++)
+		for (int i=0; i<e->pointlights.cnt; i++) {
 			e->pointlights.cubemaps[i].clean = 1;
-		for (int i=0; i<e->shadowcasters.cnt; i++)
+			e->pointlights.cubemaps[i].dirty_faces = e->pointlights.cubemaps[i].dynamic_faces;
+		}
+		for (int i=0; i<e->shadowcasters.cnt; i++) {
 			e->shadowcasters.cubemaps[i].basic.clean = 1;
+			e->shadowcasters.cubemaps[i].basic.dirty_faces = e->shadowcasters.cubemaps[i].basic.dynamic_faces;
+		}
 
 		/* Frag Shader Job */
-		thread_set_and_go(et, JOB_STATE_FRAG);
+		e->time_frag = timed_job(et, JOB_STATE_FRAG);
 	} else {
 		memset(e->fb, 0, SCREEN_W*FB_H);
 	}
@@ -628,12 +669,9 @@ void render(engine_threads_t *et, const float delta) {
 		talkbox_draw(&e->talkbox, e->fb, &e->assets, &e->audio, delta);
 
 	if (e->controls.show_pvs) {
-		const i32 ent_cnt = myarrlen(ecs->flags);
-		for (i32 i=0; i<ent_cnt; i++) {
-			if (bitarr_get(ecs->bit_edict, i)) {
-				uint32_t color = 13;
-				aabb_to_lines(e, ecs->edict[i].edict->absbox, color);
-			}
+		SPARSE_EACH(&ecs->set_edict, i) {
+			uint32_t color = 13;
+			aabb_to_lines(e, ecs->edict[i].edict->absbox, color);
 		}
 		render_lines(e, e->lines);
 	}
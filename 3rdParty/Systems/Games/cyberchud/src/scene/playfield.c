@@ -17,7 +17,7 @@ void playfield_init(engine_t* e) {
 
 	e->ui_mode = UI_MODE_NONE;
 
-	const int result = assets_load_level(&e->assets, &e->ecs.alloc, 0);
+	const int result = assets_load_level(&e->assets, &e->ecs.alloc, e->current_level);
 	ecs_reset(&e->ecs);
 	SV_ClearWorld(e);
 
@@ -111,12 +111,13 @@ void title_init(engine_t* e) {
 #endif
 	e->scene_time = 0;
 	e->scene_transition = 1;
+	e->current_level = 0;
 	e->controls.show_menu = 1;
 	e->warpcircle.w = -1;
 	e->controls.show_wireframe = 1;
 	SDL_SetRelativeMouseMode(SDL_FALSE);
 
-	assets_load_level(&e->assets, &e->ecs.alloc, WAD_BSP_LEVELTITLE_BSP/2);
+	assets_load_level(&e->assets, &e->ecs.alloc, ASSETS_TITLE_LEVEL);
 	ecs_reset(&e->ecs);
 	SV_ClearWorld(e);
 
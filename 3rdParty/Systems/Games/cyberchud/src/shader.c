@@ -1,4 +1,7 @@
 #include <assert.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 #include "shader.h"
 #include "debug.h"
@@ -46,45 +49,31 @@ void draw_frags(const engine_t* const e, frag_uniform_t* const uni, thread_vert_
 		}
 	}
 
-	/* convert internal fragment fb to 16-color */
+	/* convert internal fragment fb to 16-color, only the rows this frame's interlace field shows */
+	const palette_quant_t* const quant = &e->quant;
 	u8* const fb = uni->fb;
-	const int y2 = uni->mask_y2;
-	const int interlace = uni->interlace;
-
-	if (e->vfx_flags.screen_pulse) {
-		const float t = fmodf(e->screen_pulse_time*2, 1.0f);
-		for (int y=uni->mask_y1; y<y2; y++) {
-			if ((y+interlace) % 2) continue;
-			for (int x=0; x<SCREEN_W; x++) {
-				uint8_t val = fb[y*SCREEN_W+x];
-				if (!(val&128)) {
-					val += 64.0f*t;
-					if (val > 127) val = 127;
-					val = (float)val/(127.0f/10.0f);
-				} else {
-					const uint8_t alt_idx_lookup[4] = {0, 13, 14, 15};
-					const size_t pal_idx = (float)val/(255.0f/3.0f);
-					val = alt_idx_lookup[pal_idx];
-				}
-				assert(val < PALETTE_SIZE);
-				fb[y*SCREEN_W+x] = val;
-			}
-		}
-	} else {
-		for (int y=uni->mask_y1; y<y2; y++) {
-			if ((y+interlace) % 2) continue;
-			for (int x=0; x<SCREEN_W; x++) {
-				uint8_t val = fb[y*SCREEN_W+x];
-				if (!(val&128)) {
-					val = (float)val/(127.0f/10.0f);
-				} else {
-					const uint8_t alt_idx_lookup[4] = {0, 13, 14, 15};
-					const size_t pal_idx = (float)val/(255.0f/3.0f);
-					val = alt_idx_lookup[pal_idx];
-				}
-				assert(val < PALETTE_SIZE);
-				fb[y*SCREEN_W+x] = val;
-			}
+	const int y1 = uni->mask_y1 + ((uni->mask_y1+uni->interlace) & 1);
+#ifdef __AVX2__
+	/* index = lut[0] + how many steps the byte is at or past, signed compares so bias by 0x80 */
+	const __m256i bias = _mm256_set1_epi8((char)0x80);
+	const __m256i base = _mm256_set1_epi8(quant->lut[0]);
+	__m256i steps[PALETTE_SIZE];
+	for (int s=0; s<quant->step_cnt; s++)
+		steps[s] = _mm256_set1_epi8((char)((quant->steps[s]-1)^0x80));
+#endif
+	for (int y=y1; y<uni->mask_y2; y+=2) {
+		u8* const row = &fb[y*SCREEN_W];
+		int x = 0;
+#ifdef __AVX2__
+		for (; x+32<=SCREEN_W; x+=32) {
+			const __m256i val = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&row[x]), bias);
+			__m256i idx = base;
+			for (int s=0; s<quant->step_cnt; s++)
+				idx = _mm256_sub_epi8(idx, _mm256_cmpgt_epi8(val, steps[s]));
+			_mm256_storeu_si256((__m256i*)&row[x], idx);
 		}
+#endif
+		for (; x<SCREEN_W; x++)
+			row[x] = quant->lut[row[x]];
 	}
 }
@@ -10,11 +10,6 @@
 void cubemap_update(cubemap_t* const shadow, const vec3s pos, const float brightness, visflags_t* const visflags) {
 	shadow->brightness = brightness;
 
-	/* Clear Depthbuffer */
-	for (int i=0; i<6; i++) {
-		for (size_t j=0; j<SHADOW_TOTAL; j++)
-			shadow->depthbuffer[i][j] = FLT_MAX;
-	}
 	/* Set Visflags */
 	shadow->visflags = visflags;
 
@@ -53,11 +48,7 @@ void cubemap_update(cubemap_t* const shadow, const vec3s pos, const float bright
 	target = (vec3s){{pos.x, pos.y, pos.z-1}};
 	glm_lookat((float*)pos.raw, target.raw, up.raw, shadow->cube_mtx[5].raw);
 
-	/* Clear Cache */
-	for (int i=0; i<CUBE_FACE_CNT; i++) {
-		for (size_t j=0; j<SHADOW_TOTAL; j++)
-			shadow->cachebuffer[i][j] = FLT_MAX;
-	}
+	/* depthbuffer and cachebuffer get rebuilt by the shadow job */
 }
 
 void cubemap_init(cubemap_t* shadow) {
@@ -73,10 +64,33 @@ void cubemap_clear(cubemap_t* cubemap) {
 	}
 }
 
+void cubemap_clear_rows(cubemap_t* cubemap, const int y1, const int y2) {
+	for (int i=0; i<CUBE_FACE_CNT; i++) {
+		float* const db = cubemap->depthbuffer[i];
+		for (size_t j=y1*SHADOW_WIDTH; j<(size_t)y2*SHADOW_WIDTH; j++)
+			db[j] = FLT_MAX;
+	}
+}
+
+/* Faces of a job that hold at least one triangle */
+u8 cubemap_face_mask(const shadow_job_t* const job) {
+	u8 mask = 0;
+	for (int i=0; i<CUBE_FACE_CNT; i++) {
+		if (job->tri_cnt[i])
+			mask |= 1<<i;
+	}
+	return mask;
+}
+
+/* Only the faces dynamic casters touched last frame have bits set */
 void cubemap_occlusion_clear(cubemap_occlusion_t* cubemap) {
 	const size_t sz = bitarr_get_size(SHADOW_WIDTH*SHADOW_HEIGHT);
-	for (int i=0; i<6; i++)
-		memset(cubemap->shadowfield[i], 0, sz);
+	const u8 faces = cubemap->basic.clean ? cubemap->basic.dirty_faces : 0xff;
+	for (int i=0; i<CUBE_FACE_CNT; i++) {
+		if (faces & (1<<i))
+			memset(cubemap->shadowfield[i], 0, sz);
+	}
+	cubemap->basic.dirty_faces = 0;
 }
 
 void draw_shadowmap(const shadow_job_t* const job, cubemap_t* cubemaps, const i16 mask_y1, const i16 mask_y2) {
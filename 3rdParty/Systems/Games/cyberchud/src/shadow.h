@@ -23,6 +23,8 @@ typedef struct {
 	float near_plane;
 	float far_plane;
 	int clean;
+	u8 dynamic_faces; // faces with dynamic casters this frame
+	u8 dirty_faces; // faces still holding last frame's dynamic casters
 	visflags_t* visflags;
 	float depthbuffer[CUBE_FACE_CNT][SHADOW_WIDTH*SHADOW_HEIGHT];
 	float cachebuffer[CUBE_FACE_CNT][SHADOW_WIDTH*SHADOW_HEIGHT];
@@ -53,6 +55,8 @@ typedef struct {
 void cubemap_update(cubemap_t* const shadow, const vec3s pos, const float brightness, visflags_t* const visflags);
 void cubemap_init(cubemap_t* shadow);
 void cubemap_clear(cubemap_t* cubemap);
+void cubemap_clear_rows(cubemap_t* cubemap, const int y1, const int y2);
+u8 cubemap_face_mask(const shadow_job_t* const job);
 void cubemap_occlusion_clear(cubemap_occlusion_t* cubemap);
 void draw_shadowmap(const shadow_job_t* const job, cubemap_t* cubemaps, const i16 mask_y1, const i16 mask_y2);
 void draw_shadowmap_occlusion(const shadow_job_t* const job, cubemap_occlusion_t* cubemaps, const i16 mask_y1, const i16 mask_y2);
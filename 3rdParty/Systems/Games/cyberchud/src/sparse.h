@@ -0,0 +1,96 @@
+#ifndef SPARSE_H
+#define SPARSE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "utils/myds.h"
+
+/* Sparse set of entity ids
+ * dense keeps the members packed so systems only visit entities that have the component,
+ * sparse maps an id to its slot in dense (-1 when absent). Removal leaves a -1 hole in dense
+ * that the next walk packs, so members never move while a loop is visiting them. */
+typedef struct {
+	int32_t* dense;
+	int32_t* sparse;
+	int32_t holes;
+} sparse_t;
+
+static inline int32_t sparse_cnt(const sparse_t* const set) {
+	return myarrlen(set->dense) - set->holes;
+}
+
+static inline int sparse_has(const sparse_t* const set, const int32_t id) {
+	return set->sparse[id] >= 0;
+}
+
+static inline void sparse_add(sparse_t* const set, const int32_t id) {
+	if (sparse_has(set, id))
+		return;
+	set->sparse[id] = myarrlen(set->dense);
+	arrput(set->dense, id);
+}
+
+static inline void sparse_del(sparse_t* const set, const int32_t id) {
+	const int32_t slot = set->sparse[id];
+	if (slot < 0)
+		return;
+	set->dense[slot] = -1;
+	set->holes++;
+	set->sparse[id] = -1;
+}
+
+/* Closes the holes left by sparse_del, keeps the member order. Returns the count */
+static inline int32_t sparse_pack(sparse_t* const set) {
+	if (set->holes) {
+		int32_t cnt = 0;
+		for (int32_t i=0; i<myarrlen(set->dense); i++) {
+			const int32_t id = set->dense[i];
+			if (id < 0)
+				continue;
+			set->dense[cnt] = id;
+			set->sparse[id] = cnt++;
+		}
+		arrsetlen(set->dense, cnt);
+		set->holes = 0;
+	}
+	return myarrlen(set->dense);
+}
+
+/* Grows the id range, also sets up dense since myarrlen needs a header */
+static inline void sparse_resize(sparse_t* const set, const int32_t cur_size, const int32_t new_size) {
+	if (set->dense == NULL)
+		arrsetcap(set->dense, 1024);
+	arrsetlen(set->sparse, new_size);
+	for (int32_t i=cur_size; i<new_size; i++)
+		set->sparse[i] = -1;
+}
+
+static inline void sparse_clear(sparse_t* const set) {
+	for (int32_t i=0; i<myarrlen(set->dense); i++)
+		if (set->dense[i] >= 0)
+			set->sparse[set->dense[i]] = -1;
+	arrsetlen(set->dense, 0);
+	set->holes = 0;
+}
+
+static inline void sparse_free(sparse_t* const set) {
+	arrfree(set->dense);
+	arrfree(set->sparse);
+}
+
+/* Copies the members into *out (an stb_ds array) and returns the count */
+static inline int32_t sparse_copy(sparse_t* const set, int32_t** const out) {
+	const int32_t cnt = sparse_pack(set);
+	arrsetlen(*out, cnt);
+	memcpy(*out, set->dense, cnt*sizeof(int32_t));
+	return cnt;
+}
+
+/* Walks the members in order. The body may remove any member, removed ones aren't visited,
+ * members added during the walk wait for the next one. Walks of the same set don't nest */
+#define SPARSE_EACH(set, id) \
+	for (int32_t _sn=sparse_pack(set), _si=0, id; _si<_sn && ((id=(set)->dense[_si]), 1); _si++) \
+		if (id < 0) {} else
+
+#endif
@@ -1,5 +1,5 @@
 #include "tosfb.h"
-#include "bitarr.h"
+#include "planar.h"
 #include "mytime.h"
 #include "text.h"
 #include "stb_sprintf.h"
@@ -60,6 +60,7 @@ typedef struct {
 
 extern void get_tos_data(tos_data_t*);
 static tos_data_t g_tos;
+static vga_planar_t g_planar;
 
 #define VGAP_IDX          0x03C4
 #define VGAP_DATA         0x03C5
@@ -230,81 +231,29 @@ static inline void vga_update_palettes(const palette_t* const palette) {
 }
 
 static inline void write_vga(const uint8_t* const fb, const int interlace) {
-	/* static int flip = 0; */
-	static u8 plane_cache[SCREEN_W*SCREEN_H/2];
-
-#if 0
-	static u8 fb_cache[SCREEN_W*SCREEN_H];
-	static u8 dirty[SCREEN_W*SCREEN_H/8];
-	/* Update FB Cache and Mark Dirty */
-	/* memset(dirty, 0x00, sizeof(dirty)); */
-	for (int y=8; y<SCREEN_H; y++) {
-		const u8* pfb = fb + y*SCREEN_W;
-		u8* pfb_cache = fb_cache + y*SCREEN_W;
-		for (int x=0; x<SCREEN_W/8; x++, pfb+=8, pfb_cache+=8) {
-			for (int i=0; i<8; i++) {
-				if (pfb_cache[i] != pfb[i]) {
-					pfb_cache[i] = pfb[i];
-					bitarr_set(dirty, y*SCREEN_W+x);
-				}
-			}
-		}
-	}
-#endif
-
-	/* Regenerate Plane Cache */
-	memset(plane_cache, 0, sizeof(plane_cache));
-	for (int plane=0; plane<4; plane++) {
-		u8* pplane = &plane_cache[plane*SCREEN_W*SCREEN_H/8];
-		for (int y=0; y<SCREEN_H; y++) {
-			for (int x=0; x<SCREEN_W/8; x++, pplane++) {
-				for (int i=0; i<8; i++) {
-					*pplane |= ((fb[y*SCREEN_W+x*8+i]&(1u<<plane)) >>(plane)) <<(7-i);
-				}
-			}
-		}
-	}
+	/* Convert Changed Spans */
+	vga_planar_t* const vp = &g_planar;
+	const u32 dirty_cnt = vga_planar_update(vp, fb, interlace);
+	if (!dirty_cnt)
+		return;
 
 	/* vsync */
 	/* while (inb(0x3da)&8) {} */
 	/* while (!(inb(0x3da)&8)) {} */
 
-	/* Transfer Memory to VGA */
-	for (int y=0; y<SCREEN_H; y++) {
-		/* if ((y+flip*2) % 3) continue; // interlace */
-		if ((y+interlace) % 2) continue;
-		for (int plane=0; plane<4; plane++) {
-			u8* pp = g_tos.vga_mem;
-			const u8* const pc = &plane_cache[plane*SCREEN_W*SCREEN_H/8];
-			outb(VGAP_IDX, VGAR_MAP_MASK);
-			outb(VGAP_DATA, 1u<<plane);
-#if 0
-			for (int x=0; x<SCREEN_W/8; x++) {
-				const size_t offset = y*SCREEN_W+x;
-				if (bitarr_get(dirty, offset)) {
-					/* bitarr_clear(dirty, offset); */
-					const size_t idx = (y*SCREEN_W + x*8)/8;
-					/* *(uint64_t*)(&pp[idx]) = *(uint64_t*)(&pc[idx]); */
-					pp[idx] = pc[idx];
-				}
-			}
-#else
-			memcpy(&pp[y*SCREEN_W/8], &pc[y*SCREEN_W/8], 640/8);
-#endif
-		}
-		/* memset(dirty+y*SCREEN_W/8, 0, 640/8); */
-	}
-
-#if 0
-	for (int plane=0; plane<4; plane++) {
-		const u8* const pc = plane_cache + plane*SCREEN_W*SCREEN_H/8;
+	/* Transfer Memory to VGA, one plane select per plane */
+	u8* const pp = g_tos.vga_mem;
+	for (int plane=0; plane<VGA_PLANE_CNT; plane++) {
+		const u8* const pc = vp->planes[plane];
 		outb(VGAP_IDX, VGAR_MAP_MASK);
-		outb(VGAP_DATA, 1<<plane);
-		memcpy(vga_mem, pc, 640*480/8);
+		outb(VGAP_DATA, 1u<<plane);
+		for (u32 i=0; i<dirty_cnt; i++) {
+			const int y = vp->dirty_rows[i];
+			const vga_span_t span = vp->spans[y];
+			const size_t idx = y*VGA_ROW_BYTES+span.x1;
+			memcpy(&pp[idx], &pc[idx], span.x2-span.x1);
+		}
 	}
-#endif
-
-	/* flip = !flip; */
 }
 
 void tos_get_statusline(char* str) {
@@ -373,6 +322,7 @@ void tosfb_init(tosfb_thread_t* thr, engine_t* const e, const palette_t* const p
 	thr->palette = *palette;
 
 	get_tos_data(&g_tos);
+	vga_planar_init(&g_planar);
 
 	/* Clear */
 	outb(VGAP_IDX, VGAR_MAP_MASK);
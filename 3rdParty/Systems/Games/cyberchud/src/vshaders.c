@@ -593,8 +593,7 @@ static void vert_postworld(thread_data_t* const data) {
 			clip_uni.tex_diffuse = mesh->tex_diffuse[diff_idx];
 			clip_uni.tex_normal = mesh->tex_normal;
 		}
-		lightcache_t lightcache = {0}; // TODO actually cache this lmao
-		clip_uni.ambient = R_LightPoint(&e->assets.map, ecs->pos[idxs->id], ecs->bbox[idxs->id].max.y*0.5f, &lightcache) * 0.5;
+		clip_uni.ambient = light_probes_sample(&e->probes, &e->assets.map, ecs->pos[idxs->id], ecs->bbox[idxs->id].max.y*0.5f) * 0.5;
 		if (flags.highlight) {
 			clip_uni.color_mod = 1;
 		} else {
@@ -667,58 +666,25 @@ static void shader_vert_anim_basic(const mesh_t* const mesh, const size_t fidx,
 #ifdef VERBOSE2
 	fputs("[vertex_anim]\n", stdout);
 #endif
-	/* Bone Influence */
+	/* Gather the verts job_anim already skinned */
 	out->face_idxs[idx] = mesh->faces[fidx];
 	out->face_id[idx] = fidx;
 	mat3s* const pos = &out->basic.world_pos[idx];
 	for (int pi=0; pi<3; pi++) {
-		const size_t vidx = out->face_idxs[idx].p[pi];
-		const vec4s world_pos = glms_vec4(mesh->verts[vidx].pos, 1);
-		const vec4s norm = glms_vec4(mesh->verts[vidx].norm, 0);
-		const vec4s tangent = glms_vec4(mesh->verts[vidx].tangent, 0);
-		vec4s total_pos = {0};
-		vec4s total_norm = {0};
-		vec4s total_tangent = {0};
-		const weight_t* const weights = mesh->weights[vidx].weights;
-		for (size_t i=0; i<MAX_BONE_INFLUENCE; i++) {
-			const int bone_idx = weights[i].bone_idx;
-			if (bone_idx < 0)
-				break;
-
-			/* Transform Position */
-			vec4s local_pos;
-			glm_mat4_mulv(uni->anim.bone_mtx[bone_idx].raw, (float*)world_pos.raw, local_pos.raw);
-			const float weight = weights[i].weight;
-			glm_vec4_scale(local_pos.raw, weight, local_pos.raw);
-			glm_vec4_add(total_pos.raw, local_pos.raw, total_pos.raw);
-
-			vec4s local_norm;
-			glm_mat4_mulv(uni->anim.bone_mtx[bone_idx].raw, (float*)norm.raw, local_norm.raw);
-			glm_vec4_scale(local_norm.raw, weight, local_norm.raw);
-			glm_vec4_add(total_norm.raw, local_norm.raw, total_norm.raw);
-
-			vec4s local_tangent;
-			glm_mat4_mulv(uni->anim.bone_mtx[bone_idx].raw, (float*)tangent.raw, local_tangent.raw);
-			glm_vec4_scale(local_tangent.raw, weight, local_tangent.raw);
-			glm_vec4_add(total_tangent.raw, local_tangent.raw, total_tangent.raw);
-		}
+		const skin_vert_t* const vert = &uni->skin[out->face_idxs[idx].p[pi]];
 
 		/* Copy Position (world space) */
-		glm_mat4_mulv((vec4*)uni->mtx.raw, total_pos.raw, total_pos.raw);
-		pos->col[pi].x = total_pos.x;
-		pos->col[pi].y = total_pos.y;
-		pos->col[pi].z = total_pos.z;
+		const vec4s world_pos = glms_mat4_mulv(uni->mtx, glms_vec4(vert->pos, 1));
+		pos->col[pi].x = world_pos.x;
+		pos->col[pi].y = world_pos.y;
+		pos->col[pi].z = world_pos.z;
 
 		/* Copy Normal (model space) */
-		out->norms[idx].col[pi].x = total_norm.x;
-		out->norms[idx].col[pi].y = total_norm.y;
-		out->norms[idx].col[pi].z = total_norm.z;
+		out->norms[idx].col[pi] = vert->norm;
 
 		/* Copy Tangent (model space) */
-		vec3_assert(total_tangent.raw);
-		out->tangents[idx].col[pi].x = total_tangent.x;
-		out->tangents[idx].col[pi].y = total_tangent.y;
-		out->tangents[idx].col[pi].z = total_tangent.z;
+		vec3_assert(vert->tangent.raw);
+		out->tangents[idx].col[pi] = vert->tangent;
 	}
 }
 
@@ -1049,7 +1015,10 @@ job_vert_basic_no_plsc
 
 		const flag_t flags = ecs->flags[job->id];
 		if (flags.bones) {
-			vuniform.anim = ecs->anim[job->id];
+			const model_basic_t* const model = &ecs->model[job->id].model_anim->basic;
+			vuniform.skin = ecs->anim[job->id].skin;
+			for (uint32_t mi=0; mi<job->mesh_idx; mi++)
+				vuniform.skin += model->meshes[mi].vert_cnt;
 			for (uint32_t fi=0; fi<job->face_cnt; fi++) {
 				const size_t fidx = job->face_idx+fi;
 				const size_t out_idx = myarrlenu(data->world_tris.basic.world_pos);
@@ -1120,14 +1089,6 @@ job_vert_basic_no_plsc
 				}
 			}
 		} else if (flags.bsp_model) {
-#ifdef SHADER_PL
-			pointlight_data_t* const pointlights = &e->pointlights;
-			vert_out_cubemap_t* const pointlight_tris = data->pointlight_tris;
-#endif
-#ifdef SHADER_SC
-			shadowmap_data_t* const shadowcasters = &e->shadowcasters;
-			vert_out_cubemap_t* const shadowcaster_tris = data->shadowcaster_tris;
-#endif
 			for (uint32_t fi=0; fi<job->face_cnt; fi++) {
 				/* basic transform to copy */
 				mat3s world_tri;
@@ -1137,28 +1098,15 @@ job_vert_basic_no_plsc
 				stbds_header(data->world_tris.basic.world_pos)->length++;
 				idx_data.cnt++;
 
-#ifdef SHADER_PL
+				/* doors move, so they're dynamic casters drawn over the cached world */
 				if (mesh->mat_type != 1) {
-					for (int ci=0; ci<pointlights->cnt; ci++) {
-						vert_out_mesh_basic_t* const cube_out = &pointlight_tris[ci].world;
-						const size_t idx = myarrlenu(cube_out->world_pos);
-						cube_out->world_pos[idx] = world_tri;
-						stbds_header(cube_out->world_pos)->length++;
-						idxs_pointlights_world[ci].cnt++;
-					}
-				}
+#ifdef SHADER_PL
+					push_cubemap(&world_tri, e->pointlights.cnt, idxs_pointlights_models, data->pointlight_tris);
 #endif
 #ifdef SHADER_SC
-				if (mesh->mat_type != 1) {
-					for (int ci=0; ci<shadowcasters->cnt; ci++) {
-						vert_out_mesh_basic_t* const cube_out = &shadowcaster_tris[ci].world;
-						const size_t idx = myarrlenu(cube_out->world_pos);
-						cube_out->world_pos[idx] = world_tri;
-						stbds_header(cube_out->world_pos)->length++;
-						idxs_shadowcasters_world[ci].cnt++;
-					}
-				}
+					push_cubemap(&world_tri, e->shadowcasters.cnt, idxs_shadowcasters_models, data->shadowcaster_tris);
 #endif
+				}
 			}
 		} else if (flags.static_model_osc) {
 			for (uint32_t fi=0; fi<job->face_cnt; fi++) {
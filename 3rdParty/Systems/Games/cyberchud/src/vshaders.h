@@ -7,7 +7,7 @@
 typedef struct {
 	mat4s mtx;
 	vec4s warpcircle;
-	anim_t anim;
+	const skin_vert_t* skin; // this mesh's slice of anim_t.skin
 } vert_uniform_t;
 
 void job_vert_basic(thread_data_t* data);
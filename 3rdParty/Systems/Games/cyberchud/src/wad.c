@@ -1,65 +1,23 @@
 #include <stdlib.h>
+#include <string.h>
+#if defined(PLATFORM_DESKTOP) && defined(__unix__) && !defined(__EMSCRIPTEN__)
+#define WAD_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #define WAD_IMPLEMENTATION
 #include "wad.h"
+#include "mytime.h"
 #include "text.h"
+#include "thread.h"
 #include "utils/mymalloc.h"
 
-static int uncompressed_read(FILE* fin, const file_header_t header, char* const dest) {
-	if (fseek(fin, header.pos, SEEK_SET) == -1)
-		return 1;
-	if (fread(dest, 1, header.size, fin) != header.size)
-		return 1;
-	return 0;
-}
-
-static int compressed_read(const wad_t* const arc, const file_header_t header, char* const dest) {
-	if (fseek(arc->fp, header.pos, SEEK_SET) == -1)
-		return 1;
-
-	size_t remaining = header.size_compressed;
-	size_t toRead = header.size_compressed < arc->buff_in_size ? header.size_compressed: arc->buff_in_size;
-	size_t lastRet = 0;
-	size_t read;
-	ZSTD_outBuffer output = { dest, header.size, 0 };
-	while ((read = fread(arc->buff_in, 1, toRead, arc->fp))) {
-		if (read != toRead) {
-			return 1;
-		}
-		remaining -= read;
-		toRead = remaining < arc->buff_in_size ? remaining : arc->buff_in_size;
-		ZSTD_inBuffer input = { arc->buff_in, read, 0 };
-		/* Given a valid frame, zstd won't consume the last byte of the frame
-		 * until it has flushed all of the decompressed data of the frame.
-		 * Therefore, instead of checking if the return code is 0, we can
-		 * decompress just check if input.pos < input.size.
-		 */
-		while (input.pos < input.size) {
-			/* The return code is zero if the frame is complete, but there may
-			 * be multiple frames concatenated together. Zstd will automatically
-			 * reset the context when a frame is complete. Still, calling
-			 * ZSTD_DCtx_reset() can be useful to reset the context to a clean
-			 * state, for instance if the last decompression call returned an
-			 * error.
-			 */
-			size_t const ret = ZSTD_decompressStream(arc->dctx, &output , &input);
-			if (ZSTD_isError(ret))
-				return ret;
-			lastRet = ret;
-		}
-	}
-
-	if (lastRet != 0) {
-		/* The last return value from ZSTD_decompressStream did not end on a
-		 * frame, but we reached the end of the file! We assume this is an
-		 * error, and the input was truncated.
-		 */
-		myprintf("EOF before end of stream: %zu\n", lastRet);
-		return 1;
-	}
-
-	return 0;
-}
+#define WAD_PENDING 0
+#define WAD_READY 1
+#define WAD_FAILED 2
 
 static void* zstd_malloc(void* __attribute__((unused)) opaque, size_t size) {
 #ifndef NDEBUG
@@ -79,78 +37,211 @@ static void zstd_free(void* __attribute__((unused)) opaque, void* ptr) {
 	myfree(ptr);
 }
 
-int wad_init(wad_t* const arc, const char* filename) {
-	arc->fp = fopen(filename, "rb");
-	if (arc->fp == NULL) {
+ZSTD_DCtx* wad_dctx_create(void) {
+	ZSTD_customMem customMem = { zstd_malloc, zstd_free, NULL };
+	return ZSTD_createDCtx_advanced(customMem);
+}
+
+/* Map the file where we can, bsp_transform patches lumps in place so the mapping is private+writable.
+ * TempleOS has no mmap, its fopen already reads the whole file so one big fread is the cheapest there. */
+static int wad_open(wad_t* const arc, const char* filename) {
+#ifdef WAD_MMAP
+	const int fd = open(filename, O_RDONLY);
+	if (fd == -1) {
+		myprintf("[wad_init] open failed: %s\n", filename);
+		return 1;
+	}
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		return 1;
+	}
+#ifdef MAP_POPULATE
+	const int flags = MAP_PRIVATE|MAP_POPULATE;
+#else
+	const int flags = MAP_PRIVATE;
+#endif
+	void* const data = mmap(NULL, st.st_size, PROT_READ|PROT_WRITE, flags, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		myprintf("[wad_init] mmap failed: %s\n", filename);
+		return 1;
+	}
+	arc->file_data = data;
+	arc->file_size = st.st_size;
+	arc->mapped = 1;
+#else
+	FILE* const fp = fopen(filename, "rb");
+	if (fp == NULL) {
 		myprintf("[wad_init] fopen failed: %s\n", filename);
 		return 1;
 	}
-
-#ifndef NDEBUG
-	if(fseek(arc->fp, 0, SEEK_END) != 0) {
+	if (fseek(fp, 0, SEEK_END) != 0) {
 		myprintf("[wad_init] ERR! %s fseek SEEK_END\n", filename);
-		fclose(arc->fp);
+		fclose(fp);
+		return 1;
+	}
+	arc->file_size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	char* const data = aligned_alloc(16, (arc->file_size+15)&~(size_t)15);
+	if (data == NULL || fread(data, 1, arc->file_size, fp) != arc->file_size) {
+		myprintf("[wad_init] read failed: %s size:%lu\n", filename, arc->file_size);
+		free(data);
+		fclose(fp);
 		return 1;
 	}
-	const long size = ftell(arc->fp);
-	myprintf("[wad_init] %s size:%ld\n", filename, size);
-	fseek(arc->fp, 0, SEEK_SET);
+	fclose(fp);
+	arc->file_data = data;
+	arc->mapped = 0;
 #endif
+#ifndef NDEBUG
+	myprintf("[wad_init] %s size:%lu mapped:%d\n", filename, arc->file_size, arc->mapped);
+#endif
+	return 0;
+}
 
-	arc->buff_in_size = ZSTD_DStreamInSize();
-	arc->buff_in = mymalloc(arc->buff_in_size);
+int wad_init(wad_t* const arc, const char* filename) {
+	memset(arc, 0, sizeof(*arc));
+	if (wad_open(arc, filename))
+		return 1;
 
-	if (arc->buff_in == NULL) {
-		myprintf("[wad_init] arc->buff_in == NULL, bytes:%lu\n", arc->buff_in_size);
+	arc->lumps = malloc(sizeof(const char*)*WAD_TOTAL);
+	arc->ready = calloc(WAD_TOTAL, sizeof(uint8_t));
+	arc->heap = WAD_HEAP_SIZE ? aligned_alloc(16, WAD_HEAP_SIZE) : NULL;
+	if (arc->lumps == NULL || arc->ready == NULL || (WAD_HEAP_SIZE && arc->heap == NULL)) {
+		myprintf("[wad_init] alloc failed, heap:%lu\n", (size_t)WAD_HEAP_SIZE);
+		wad_free(arc);
 		return 1;
 	}
 
-	ZSTD_customMem customMem = { zstd_malloc, zstd_free, NULL };
-	arc->dctx = ZSTD_createDCtx_advanced(customMem);
-	if (arc->dctx == NULL) {
-		fputs("[wad_init] arc->dctx == NULL\n", stderr);
+#if WAD_GLOB
+	/* one frame holding every lump, nothing to split up */
+	ZSTD_DCtx* const dctx = wad_dctx_create();
+	const size_t ret = ZSTD_decompressDCtx(dctx, arc->heap, WAD_GLOB_SIZE, arc->file_data, WAD_GLOB_SIZE_ZSTD);
+	ZSTD_freeDCtx(dctx);
+	if (ZSTD_isError(ret)) {
+		myprintf("[wad_init] glob: %s\n", ZSTD_getErrorName(ret));
+		wad_free(arc);
 		return 1;
 	}
+	for (size_t i=0; i<WAD_TOTAL; i++) {
+		arc->lumps[i] = arc->heap + g_wad[i].pos;
+		arc->ready[i] = WAD_READY;
+	}
+#else
+	/* raw lumps are used straight from the file, compressed ones get a slot in the heap */
+	size_t heap_pos = 0;
+	for (size_t i=0; i<WAD_TOTAL; i++) {
+		const file_header_t* const header = &g_wad[i];
+		if (header->size_compressed) {
+			arc->lumps[i] = arc->heap + heap_pos;
+			heap_pos += (header->size+15) & ~(size_t)15;
+		} else {
+			arc->lumps[i] = arc->file_data + header->pos;
+			arc->ready[i] = WAD_READY;
+		}
+	}
+#endif
 
+	arc->mutex = CreateMutex();
+	arc->cond = CreateCond();
 	return 0;
 }
 
-void wad_free(wad_t* const arc) {
-	myfree(arc->buff_in);
-	ZSTD_freeDCtx(arc->dctx);
+const char* wad_lump(const wad_t* const arc, const WAD_IDX idx) {
+	return arc->lumps[idx];
 }
 
-int wad_get(const wad_t* const arc, const WAD_IDX idx, char* data) {
-	const file_header_t* header = &g_wad[idx];
-	if (header->size_compressed > 0) {
-		if (compressed_read(arc, *header, data))
-			return 1;
-	} else {
-		uncompressed_read(arc->fp, *header, data);
+static int wad_decompress(wad_t* const arc, ZSTD_DCtx* const dctx, const uint32_t idx) {
+	const file_header_t* const header = &g_wad[idx];
+	const size_t ret = ZSTD_decompressDCtx(dctx, (char*)arc->lumps[idx], header->size, arc->file_data + header->pos, header->size_compressed);
+	if (ZSTD_isError(ret) || ret != header->size) {
+		myprintf("[wad_decompress] %s: %s\n", header->filename, ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "short frame");
+		return 1;
 	}
 	return 0;
 }
 
-int wad_get_glob(const wad_t* const arc, char* data) {
-#ifndef NDEBUG
-	myprintf("[wad_get_glob] wad:%lx data:%lx\n", arc, data);
-#endif
-	file_header_t header;
-	header.pos = 0;
-	header.size = WAD_GLOB_SIZE;
-	header.size_compressed = WAD_GLOB_SIZE_ZSTD;
-	compressed_read(arc, header, data);
-#ifndef NDEBUG
-	myprintf("[wad_get_glob] done wad:%lx data:%lx\n", arc, data);
-#endif
+void wad_queue(wad_t* const arc, const uint32_t* const idxs, const uint32_t cnt) {
+	arc->queue = idxs;
+	arc->queue_cnt = cnt;
+	arc->queue_pos = 0;
+}
+
+/* Hand out lumps of the current queue until it runs dry, called by every worker */
+int wad_decompress_queue(wad_t* const arc, ZSTD_DCtx* const dctx) {
+	int err = 0;
+	uint32_t i;
+	while ((i = __atomic_fetch_add(&arc->queue_pos, 1, __ATOMIC_RELAXED)) < arc->queue_cnt) {
+		const uint32_t idx = arc->queue[i];
+		const int failed = wad_decompress(arc, dctx, idx);
+		__atomic_store_n(&arc->ready[idx], failed ? WAD_FAILED : WAD_READY, __ATOMIC_RELEASE);
+		err |= failed;
+	}
+	if (err)
+		__atomic_store_n(&arc->error, 1, __ATOMIC_RELAXED);
+	return err;
+}
+
+static int wad_stream_thread(void* data) {
+	wad_t* const arc = data;
+	ZSTD_DCtx* const dctx = wad_dctx_create();
+	const TIME_TYPE start = get_time();
+	for (uint32_t i=0; i<arc->stream_cnt; i++) {
+		const uint32_t idx = arc->stream[i];
+		const int failed = dctx == NULL || wad_decompress(arc, dctx, idx);
+		LockMutex(arc->mutex);
+		arc->ready[idx] = failed ? WAD_FAILED : WAD_READY;
+		CondBroadcast(arc->cond);
+		UnlockMutex(arc->mutex);
+	}
+	ZSTD_freeDCtx(dctx);
+	myprintf("[wad_stream] %u lumps in %.2fms\n", arc->stream_cnt, time_diff(start, get_time())*1000.0f);
 	return 0;
 }
 
-int wad_get_malloc(const wad_t* const arc, const WAD_IDX idx, char** data) {
-	*data = (char*)malloc(g_wad[idx].size);
-	if (*data == NULL)
+/* Decompress lumps in the background, wad_wait blocks until one has landed */
+int wad_stream(wad_t* const arc, const uint32_t* const idxs, const uint32_t cnt) {
+	if (cnt == 0)
+		return 0;
+	arc->stream = malloc(sizeof(uint32_t)*cnt);
+	if (arc->stream == NULL)
 		return 1;
+	memcpy(arc->stream, idxs, sizeof(uint32_t)*cnt);
+	arc->stream_cnt = cnt;
+	arc->stream_thread = CreateThread(&wad_stream_thread, "wad", arc);
+	return arc->stream_thread == NULL;
+}
 
-	wad_get(arc, idx, *data);
-	return 0;
+int wad_wait(wad_t* const arc, const WAD_IDX idx) {
+	if (__atomic_load_n(&arc->ready[idx], __ATOMIC_ACQUIRE) == WAD_PENDING) {
+		LockMutex(arc->mutex);
+		while (arc->ready[idx] == WAD_PENDING)
+			CondWait(arc->cond, arc->mutex);
+		UnlockMutex(arc->mutex);
+	}
+	return arc->ready[idx] != WAD_READY;
+}
+
+void wad_free(wad_t* const arc) {
+	if (arc->stream_thread) {
+		int status;
+		WaitThread(arc->stream_thread, &status);
+		arc->stream_thread = NULL;
+	}
+	if (arc->mutex)
+		DestroyMutex(arc->mutex);
+	if (arc->cond)
+		DestroyCond(arc->cond);
+#ifdef WAD_MMAP
+	if (arc->mapped && arc->file_data)
+		munmap((void*)arc->file_data, arc->file_size);
+#endif
+	if (!arc->mapped)
+		free((void*)arc->file_data);
+	free(arc->heap);
+	free(arc->lumps);
+	free((void*)arc->ready);
+	free(arc->stream);
+	memset(arc, 0, sizeof(*arc));
 }
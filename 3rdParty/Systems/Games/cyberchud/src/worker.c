@@ -22,12 +22,43 @@ static void calc_bone(anim_t* anim_data, const model_anim_data_t* const model_da
 	anim_data->bone_mtx[idx] = glms_mat4_mul(global_mtx, model_data->bones[idx].inv_matrix);
 }
 
+/* Skin every vertex once per pose, the vert jobs then only gather from anim->skin */
+static void skin_verts(anim_t* const anim, const model_basic_t* const model) {
+	skin_vert_t* out = anim->skin;
+	for (uint32_t mi=0; mi<model->mesh_cnt; mi++) {
+		const mesh_t* const mesh = &model->meshes[mi];
+		for (uint32_t vidx=0; vidx<mesh->vert_cnt; vidx++, out++) {
+			const vec4s pos = glms_vec4(mesh->verts[vidx].pos, 1);
+			const vec4s norm = glms_vec4(mesh->verts[vidx].norm, 0);
+			const vec4s tangent = glms_vec4(mesh->verts[vidx].tangent, 0);
+			vec4s total_pos = {0};
+			vec4s total_norm = {0};
+			vec4s total_tangent = {0};
+			const weight_t* const weights = mesh->weights[vidx].weights;
+			for (size_t i=0; i<MAX_BONE_INFLUENCE; i++) {
+				const int bone_idx = weights[i].bone_idx;
+				if (bone_idx < 0)
+					break;
+				const mat4s* const bone = &anim->bone_mtx[bone_idx];
+				const float weight = weights[i].weight;
+				total_pos = glms_vec4_muladds(glms_mat4_mulv(*bone, pos), weight, total_pos);
+				total_norm = glms_vec4_muladds(glms_mat4_mulv(*bone, norm), weight, total_norm);
+				total_tangent = glms_vec4_muladds(glms_mat4_mulv(*bone, tangent), weight, total_tangent);
+			}
+			out->pos = glms_vec3(total_pos);
+			out->norm = glms_vec3(total_norm);
+			out->tangent = glms_vec3(total_tangent);
+		}
+	}
+}
+
 /* static inline void copy_mask_area(float* restrict const dest, const float* restrict const src, const rect_i32* const mask) { */
-static inline void copy_mask_area(cubemap_t* cubemap, const int y1, const int y2) {
+static inline void copy_mask_area(cubemap_t* cubemap, const u8 faces, const int y1, const int y2) {
 	const size_t idx = y1*SHADOW_WIDTH;
 	const size_t len = (y2 - y1) * SHADOW_WIDTH * sizeof(float);
 	for (int i=0; i<CUBE_FACE_CNT; i++) {
-		memcpy(&cubemap->depthbuffer[i][idx], &cubemap->cachebuffer[i][idx], len);
+		if (faces & (1<<i))
+			memcpy(&cubemap->depthbuffer[i][idx], &cubemap->cachebuffer[i][idx], len);
 	}
 }
 
@@ -55,8 +86,10 @@ static void job_shadow(thread_data_t* const data) {
 		for (int j=0; j<pointlights->cnt; j++) {
 			cubemap_t* const cubemap = &pointlights->cubemaps[j];
 			if (cubemap->clean) {
-				copy_mask_area(cubemap, mask_y1, mask_y2);
+				/* static layer is intact except where dynamic casters were drawn last frame */
+				copy_mask_area(cubemap, cubemap->dirty_faces, mask_y1, mask_y2);
 			} else {
+				cubemap_clear_rows(cubemap, mask_y1, mask_y2);
 				for (int i=0; i<max_threads; i++) {
 					draw_shadowmap(&frag_in_data[i].pointlight_world[j], cubemap, mask_y1, mask_y2);
 				}
@@ -78,13 +111,12 @@ static void job_shadow(thread_data_t* const data) {
 		shadowmap_data_t* const shadowcasters = &e->shadowcasters;
 		for (int j=0; j<shadowcasters->cnt; j++) {
 			cubemap_occlusion_t* const cubemap = &shadowcasters->cubemaps[j];
-			if (cubemap->basic.clean) {
-				copy_mask_area(&cubemap->basic, mask_y1, mask_y2);
-			} else {
+			/* occlusion only writes the shadowfield, so the depthbuffer stays static */
+			if (!cubemap->basic.clean) {
+				cubemap_clear_rows(&cubemap->basic, mask_y1, mask_y2);
 				for (int i=0; i<max_threads; i++) {
 					draw_shadowmap(&frag_in_data[i].shadow_world[j], &cubemap->basic, mask_y1, mask_y2);
 				}
-				cubemap_update_cache(&cubemap->basic, mask_y1, mask_y2);
 			}
 		}
 		for (int i=0; i<max_threads; i++) {
@@ -135,6 +167,17 @@ static void job_frag(thread_data_t* data) {
 	data->frag_time = time_diff(start, get_time())*1000;
 }
 
+static void job_wad(thread_data_t* const data) {
+	wad_t* const wad = &data->e->assets.wad;
+	ZSTD_DCtx* const dctx = wad_dctx_create();
+	if (dctx == NULL) {
+		wad->error = 1;
+		return;
+	}
+	wad_decompress_queue(wad, dctx);
+	ZSTD_freeDCtx(dctx);
+}
+
 static int job_anim(thread_data_t* data) {
 	/* myprintf("calc_bone_thread, data:%p cnt:%lu\n", data, data->cnt); */
 	ecs_t* const ecs = &data->e->ecs;
@@ -143,8 +186,12 @@ static int job_anim(thread_data_t* data) {
 		const uint32_t idx = data->entities[i];
 		anim_t* const anim = &ecs->anim[idx];
 		const model_anim_data_t* const model = ecs->model[idx].model_anim;
-		bone_update(anim, model->basic.bone_cnt, data->delta*1000);
+		/* lod_delta holds the time since this model's last pose, render.c may skip frames far away */
+		bone_update(anim, model->basic.bone_cnt, anim->lod_delta*1000);
 		calc_bone(anim, model, 0, glms_mat4_identity());
+		skin_verts(anim, &model->basic);
+		anim->lod_delta = 0;
+		anim->skinned = 1;
 	}
 	data->anim_time = time_diff(start, get_time())*1000;
 	return 0;
@@ -284,6 +331,18 @@ static int thread_func(thread_data_t* data) {
 #endif
 				job_frag(data);
 				break;
+			case JOB_STATE_WAD:
+#ifdef WORKER_VERBOSE
+				myprintf("[thread_func wad] id:%d thr:0x%lx waiting:%d\n", data->thread_id, data->thread, *data->waiting_thread_cnt);
+#endif
+				job_wad(data);
+				break;
+			case JOB_STATE_PROBES:
+#ifdef WORKER_VERBOSE
+				myprintf("[thread_func probes] id:%d thr:0x%lx waiting:%d\n", data->thread_id, data->thread, *data->waiting_thread_cnt);
+#endif
+				light_probes_bake(&e->probes, &e->assets.map, data->thread_id, e->cpu_cnt);
+				break;
 			case JOB_STATE_QUIT:
 #ifndef NDEBUG
 				myprintf("[job quit] id:%d thr:0x%lx wait:%d jobs:%d\n", data->thread_id, data->thread, *data->waiting_thread_cnt, *data->jobs_queued);
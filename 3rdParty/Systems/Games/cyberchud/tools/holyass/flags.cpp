@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "flags.h"
@@ -6,11 +7,16 @@
 #define REQUIRED_ARGS 3
 
 int flags(cfg_t *cfg, const int argc, const char *argv[]) {
-	const char* helpStr = "holyass [OPTIONS] [INPUT] [OUTPUT]\n"
-		"  -s  Skeleton Mode\n";
+	const char* helpStr = "holyass [OPTIONS] [INPUT] [OUTPUT] [INPUT OUTPUT ...]\n"
+		"  -s  Skeleton Mode\n"
+		"  -f  Force, convert even if OUTPUT is newer than INPUT\n"
+		"  -j  Thread Count (default: CPU count)\n";
 
 	/* Defaults */
 	cfg->mode = MODE_BASIC;
+	cfg->force = 0;
+	cfg->thread_cnt = 0;
+	cfg->tool_path = argv[0];
 
 	/* Handle Flags */
 	for (int i=1; i<argc; i++) {
@@ -20,10 +26,17 @@ int flags(cfg_t *cfg, const int argc, const char *argv[]) {
 				cfg->mode = MODE_SKELETON;
 			} else if (strcmp(argv[i], "-a")==0) {
 				cfg->mode = MODE_BASIC_ANIM;
+			} else if (strcmp(argv[i], "-f")==0) {
+				cfg->force = 1;
+			} else if (strcmp(argv[i], "-j")==0) {
+				cfg->flagCount++;
+				cfg->thread_cnt = atoi(argv[++i]);
 			} else if (strcmp(argv[i], "-h")==0 || strcmp(argv[i], "-help")==0 || strcmp(argv[i], "--help")==0) {
 				fprintf(stderr, "%s", helpStr);
 				return 1;
 			}
+		} else {
+			break;
 		}
 	}
 
@@ -32,8 +45,15 @@ int flags(cfg_t *cfg, const int argc, const char *argv[]) {
 		return 1;
 	}
 
-	cfg->filename_input = argv[cfg->flagCount+1];
-	cfg->filename_output = argv[cfg->flagCount+2];
+	const int file_args = argc-cfg->flagCount-1;
+	if (file_args%2 != 0) {
+		fprintf(stderr, "ERROR: INPUT without OUTPUT\n%s", helpStr);
+		return 1;
+	}
+
+	cfg->file_cnt = file_args/2;
+	cfg->filename_input = argv+cfg->flagCount+1;
+	cfg->filename_output = argv+cfg->flagCount+2;
 
 	return 0;
 }
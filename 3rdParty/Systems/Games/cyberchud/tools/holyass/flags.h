@@ -11,8 +11,12 @@ typedef enum {
 typedef struct {
 	int flagCount;
 	MODE mode;
-	const char* filename_input;
-	const char* filename_output;
+	int force;
+	int thread_cnt;
+	int file_cnt;
+	const char* tool_path; // outputs older than the tool get rebuilt
+	const char* const* filename_input; // file_cnt INPUT OUTPUT pairs
+	const char* const* filename_output;
 } cfg_t;
 
 int flags(cfg_t *cfg, const int argc, const char *argv[]);
@@ -1,5 +1,9 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+#include <vector>
 
 #include <assimp/cimport.h>
 #include <assimp/scene.h>
@@ -20,7 +24,10 @@ static const char* const mat_type_names[MAT_TYPE_CNT] = {
 	"scum_bg_mat",
 };
 
-cfg_t g_cfg = {0, MODE_BASIC, NULL, NULL};
+cfg_t g_cfg = {0, MODE_BASIC, 0, 0, 0, NULL, NULL, NULL};
+
+static std::atomic<int> g_next_file;
+static std::atomic<int> g_failed;
 
 inline static void print_error(const char* msg) {
 	printf("ERROR: %s\n", msg);
@@ -124,23 +131,7 @@ static int process_materials(const aiScene* const scene, model_t *model) {
 	return 0;
 }
 
-int loadasset(const char* path) {
-	const C_STRUCT aiScene* scene = aiImportFile(path,
-			aiProcess_ImproveCacheLocality|
-			aiProcess_FindDegenerates|
-			aiProcess_LimitBoneWeights|
-			/* aiProcess_GenUVCoords| */
-			aiProcess_CalcTangentSpace|
-			aiProcess_FindInvalidData|
-			aiProcess_GenBoundingBoxes|
-			aiProcess_ValidateDataStructure|
-			aiProcess_JoinIdenticalVertices|
-			aiProcess_PopulateArmatureData);
-	if (scene == NULL) {
-		fprintf(stderr, "[loadasset] ERROR can't load scene, file:%s err:%s\n", path, aiGetErrorString());
-		return 1;
-	}
-
+static int process_scene(const aiScene* const scene, const char* const filename_output) {
 #ifndef NDEBUG
 	printf("[SCENE] mNumAnimations:%u\n", scene->mNumAnimations);
 	printf("[SCENE] mNumMaterials:%u\n", scene->mNumMaterials);
@@ -360,21 +351,57 @@ int loadasset(const char* path) {
 		}
 	}
 
-	if (model_export(model, g_cfg.filename_output, g_cfg.mode)) {
-		fprintf(stderr, "[ERR] can't write filename: %s\n", g_cfg.filename_output);
+	if (model_export(model, filename_output, g_cfg.mode)) {
+		fprintf(stderr, "[ERR] can't write filename: %s\n", filename_output);
 		return EXIT_FAILURE;
 	}
 
 	return EXIT_SUCCESS;
 }
 
-int main(const int argc, const char **argv) {
-	if (flags(&g_cfg, argc, argv)) {
-		return EXIT_FAILURE;
+int loadasset(const char* path, const char* filename_output) {
+	const C_STRUCT aiScene* scene = aiImportFile(path,
+			aiProcess_ImproveCacheLocality|
+			aiProcess_FindDegenerates|
+			aiProcess_LimitBoneWeights|
+			/* aiProcess_GenUVCoords| */
+			aiProcess_CalcTangentSpace|
+			aiProcess_FindInvalidData|
+			aiProcess_GenBoundingBoxes|
+			aiProcess_ValidateDataStructure|
+			aiProcess_JoinIdenticalVertices|
+			aiProcess_PopulateArmatureData);
+	if (scene == NULL) {
+		fprintf(stderr, "[loadasset] ERROR can't load scene, file:%s err:%s\n", path, aiGetErrorString());
+		return 1;
 	}
 
+	const int ret = process_scene(scene, filename_output);
+	aiReleaseImport(scene);
+	return ret;
+}
+
+/* OUTPUT is up to date when it's newer than both INPUT and holyass itself */
+static bool up_to_date(const char* const filename_input, const char* const filename_output) {
+	std::error_code ec;
+	if (g_cfg.force)
+		return false;
+	const auto out_time = std::filesystem::last_write_time(filename_output, ec);
+	if (ec)
+		return false;
+	const auto in_time = std::filesystem::last_write_time(filename_input, ec);
+	if (ec || out_time <= in_time)
+		return false;
+	const auto tool_time = std::filesystem::last_write_time(g_cfg.tool_path, ec);
+	return ec || out_time > tool_time;
+}
+
+static int convert(const char* const filename_input, const char* const filename_output) {
+	if (up_to_date(filename_input, filename_output))
+		return EXIT_SUCCESS;
+
 	// Check and validate the specified model file extension.
-	const char* extension = strrchr(g_cfg.filename_input, '.');
+	const char* extension = strrchr(filename_input, '.');
 	if (!extension) {
 		print_error("Please provide a file with a valid extension.");
 		return EXIT_FAILURE;
@@ -387,11 +414,40 @@ int main(const int argc, const char **argv) {
 	}
 
 	// Load the model file.
-	if(0 != loadasset(g_cfg.filename_input)) {
-		print_error("[FAILED] ending program");
-		aiDetachAllLogStreams();
+	if(0 != loadasset(filename_input, filename_output)) {
+		fprintf(stderr, "[FAILED] %s\n", filename_input);
 		return EXIT_FAILURE;
 	}
 
 	return EXIT_SUCCESS;
 }
+
+/* Workers pull the next INPUT OUTPUT pair until the list runs out, each import gets its own assimp importer */
+static void convert_thread() {
+	for (int i=g_next_file++; i<g_cfg.file_cnt; i=g_next_file++) {
+		if (convert(g_cfg.filename_input[i*2], g_cfg.filename_output[i*2]))
+			g_failed = 1;
+	}
+}
+
+int main(const int argc, const char **argv) {
+	if (flags(&g_cfg, argc, argv)) {
+		return EXIT_FAILURE;
+	}
+
+	int thread_cnt = g_cfg.thread_cnt;
+	if (thread_cnt <= 0)
+		thread_cnt = std::thread::hardware_concurrency();
+	thread_cnt = MAX(1, MIN(thread_cnt, g_cfg.file_cnt));
+
+	/* main thread is worker 0 */
+	std::vector<std::thread> threads;
+	for (int i=1; i<thread_cnt; i++)
+		threads.emplace_back(convert_thread);
+	convert_thread();
+	for (auto& thread : threads)
+		thread.join();
+
+	aiDetachAllLogStreams();
+	return g_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
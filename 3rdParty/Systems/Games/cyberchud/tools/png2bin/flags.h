@@ -13,8 +13,12 @@ typedef struct {
 	int flagCount;
 	MODE mode;
 	int alt_color_enabled;
-	const char* filename_output;
-	const char* filename_input;
+	int force;
+	int thread_cnt;
+	int file_cnt;
+	const char* tool_path; // outputs older than the tool get rebuilt
+	const char* const* filename_input; // file_cnt INPUT OUTPUT pairs
+	const char* const* filename_output;
 } cfg_t;
 
 int flags(cfg_t *cfg, const int argc, const char *argv[]);
@@ -1,14 +1,47 @@
 #include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "flags.h"
 #include "lodepng.h"
 
 cfg_t g_cfg;
 
-int palette_mode(const unsigned char* const png, const size_t pngsize) {
+static atomic_int g_next_file;
+static atomic_int g_failed;
+
+/* [u16 width][u16 height][pixels], takes ownership of image.
+ * A failed write removes OUTPUT, up_to_date would take a truncated one as current. */
+static int write_bin(const char* const filename_output, const unsigned width, const unsigned height, unsigned char* const image, const size_t bytes_to_write) {
+	FILE* fp = fopen(filename_output, "wb");
+	if (!fp) {
+		fprintf(stderr, "[ERROR] can't open %s for writing\n", filename_output);
+		free(image);
+		return EXIT_FAILURE;
+	}
+
+	/* Write Header */
+	const uint16_t buffer[2] = {width, height};
+	const size_t header_written = fwrite(buffer, sizeof(uint16_t), 2, fp);
+
+	/* Write Image */
+	const size_t bytes_written = fwrite(image, 1, bytes_to_write, fp);
+	free(image);
+	if (fclose(fp) != 0 || header_written != 2 || bytes_written != bytes_to_write) {
+		fprintf(stderr, "[ERROR] wasn't able to write bytes: %lu of %lu\n", bytes_written, bytes_to_write);
+		unlink(filename_output);
+		return EXIT_FAILURE;
+	}
+
+	return 0;
+}
+
+static int palette_mode(const unsigned char* const png, const size_t pngsize, const char* const filename_input, const char* const filename_output) {
 	unsigned width, height;
 	LodePNGState state;
 	lodepng_state_init(&state);
@@ -17,123 +50,81 @@ int palette_mode(const unsigned char* const png, const size_t pngsize) {
 	/* state.info_png.color.colortype = LCT_PALETTE; */
 	unsigned char* image = NULL;
 	unsigned error = lodepng_decode(&image, &width, &height, &state, png, pngsize);
+	lodepng_state_cleanup(&state);
 	if (error) {
-		printf("error %u: %s\n", error, lodepng_error_text(error));
+		fprintf(stderr, "[ERROR] %s %u: %s\n", filename_input, error, lodepng_error_text(error));
 		return EXIT_FAILURE;
 	}
-	/* free(png); */
-	/* lodepng_state_cleanup(&state); */
 
 	/* Convert to TempleOS Palette Style */
 	for (size_t i=0; i<width*height; i++) {
 		image[i] -= 1;
 	}
 
-	/* Write Binary */
-	FILE* fp = fopen(g_cfg.filename_output, "wb");
-	if (!fp) {
-		fprintf(stderr, "[ERROR] can't open %s for writing\n", g_cfg.filename_output);
-		return EXIT_FAILURE;
-	}
-
-	/* Write Header */
-	const uint16_t buffer[2] = {width, height};
-	fwrite(buffer, sizeof(uint16_t), 2, fp);
-
-	/* Write Image */
-	const size_t bytes_to_write = width*height;
-	const size_t bytes_written = fwrite(image, 1, bytes_to_write, fp);
-	if (bytes_written != bytes_to_write) {
-		fprintf(stderr, "[ERROR] wasn't able to write bytes: %lu of %lu\n", bytes_written, bytes_to_write);
-		return EXIT_FAILURE;
-	}
-	/* free(image); */
-
-	return 0;
+	return write_bin(filename_output, width, height, image, width*height);
 }
 
-int rgb_mode(const unsigned char* const png, const size_t pngsize) {
+static int rgb_mode(const unsigned char* const png, const size_t pngsize, const char* const filename_input, const char* const filename_output) {
 	unsigned width, height;
 	LodePNGState state;
 	lodepng_state_init(&state);
 	state.decoder.color_convert = 0;
 	unsigned char* image = NULL;
 	unsigned error = lodepng_decode(&image, &width, &height, &state, png, pngsize);
+	const LodePNGColorType colortype = state.info_png.color.colortype;
+	const unsigned bitdepth = state.info_png.color.bitdepth;
+	lodepng_state_cleanup(&state);
 	if (error) {
-		printf("error %u: %s\n", error, lodepng_error_text(error));
+		fprintf(stderr, "[ERROR] %s %u: %s\n", filename_input, error, lodepng_error_text(error));
 		return EXIT_FAILURE;
 	}
 #ifndef NDEBUG
-	printf("[rgb_mode] colortype:%u bitdepth:%u\n", state.info_png.color.colortype, state.info_png.color.bitdepth);
+	printf("[rgb_mode] colortype:%u bitdepth:%u\n", colortype, bitdepth);
 #endif
-	if (state.info_png.color.bitdepth != 8) {
-		fprintf(stderr, "[ERROR] bitdepth is not 8: %s %u\n", g_cfg.filename_input, state.info_png.color.bitdepth);
+	if (bitdepth != 8) {
+		fprintf(stderr, "[ERROR] bitdepth is not 8: %s %u\n", filename_input, bitdepth);
+		free(image);
 		return 1;
 	}
 
-	if (state.info_png.color.colortype != LCT_RGB) {
-		fprintf(stderr, "[ERROR] colortype is not RGB: %s %u\n", g_cfg.filename_input, state.info_png.color.colortype);
+	if (colortype != LCT_RGB) {
+		fprintf(stderr, "[ERROR] colortype is not RGB: %s %u\n", filename_input, colortype);
+		free(image);
 		return 1;
 	}
 
-	/* Write Binary */
-	FILE* fp = fopen(g_cfg.filename_output, "wb");
-	if (!fp) {
-		fprintf(stderr, "[ERROR] can't open %s for writing\n", g_cfg.filename_output);
-		return EXIT_FAILURE;
-	}
-
-	/* Write Header */
-	const uint16_t buffer[2] = {width, height};
-	fwrite(buffer, sizeof(uint16_t), 2, fp);
-
-	/* Write Image */
-	const size_t bytes_to_write = width*height*3;
-	const size_t bytes_written = fwrite(image, 1, bytes_to_write, fp);
-	if (bytes_written != bytes_to_write) {
-		fprintf(stderr, "[ERROR] wasn't able to write bytes: %lu of %lu\n", bytes_written, bytes_to_write);
-		return EXIT_FAILURE;
-	}
-
-	return 0;
+	return write_bin(filename_output, width, height, image, width*height*3);
 }
 
-int gray_mode(const unsigned char* const png, const size_t pngsize) {
+static int gray_mode(const unsigned char* const png, const size_t pngsize, const char* const filename_input, const char* const filename_output) {
 	unsigned width, height;
 	LodePNGState state;
 	lodepng_state_init(&state);
 	state.decoder.color_convert = 0;
 	unsigned char* image = NULL;
 	unsigned error = lodepng_decode(&image, &width, &height, &state, png, pngsize);
+	const LodePNGColorType colortype = state.info_png.color.colortype;
+	const unsigned bitdepth = state.info_png.color.bitdepth;
+	lodepng_state_cleanup(&state);
 	if (error) {
-		printf("error %u: %s\n", error, lodepng_error_text(error));
+		fprintf(stderr, "[ERROR] %s %u: %s\n", filename_input, error, lodepng_error_text(error));
 		return EXIT_FAILURE;
 	}
 #ifndef NDEBUG
-	printf("[rgb_mode] colortype:%u bitdepth:%u\n", state.info_png.color.colortype, state.info_png.color.bitdepth);
+	printf("[rgb_mode] colortype:%u bitdepth:%u\n", colortype, bitdepth);
 #endif
-	if (state.info_png.color.bitdepth != 8) {
-		fprintf(stderr, "[ERROR] bitdepth is not 8: %s %u\n", g_cfg.filename_input, state.info_png.color.bitdepth);
+	if (bitdepth != 8) {
+		fprintf(stderr, "[ERROR] bitdepth is not 8: %s %u\n", filename_input, bitdepth);
+		free(image);
 		return 1;
 	}
 
-	if (state.info_png.color.colortype != LCT_GREY) {
-		fprintf(stderr, "[ERROR] colortype is not GREY: %s %u\n", g_cfg.filename_input, state.info_png.color.colortype);
+	if (colortype != LCT_GREY) {
+		fprintf(stderr, "[ERROR] colortype is not GREY: %s %u\n", filename_input, colortype);
+		free(image);
 		return 1;
 	}
 
-	/* Write Binary */
-	FILE* fp = fopen(g_cfg.filename_output, "wb");
-	if (!fp) {
-		fprintf(stderr, "[ERROR] can't open %s for writing\n", g_cfg.filename_output);
-		return EXIT_FAILURE;
-	}
-
-	/* Write Header */
-	const uint16_t buffer[2] = {width, height};
-	fwrite(buffer, sizeof(uint16_t), 2, fp);
-
-	/* Write Image */
 	const size_t bytes_to_write = width*height;
 
 	/* remap 0-255 to 0-127 unless we support alt-color */
@@ -142,46 +133,96 @@ int gray_mode(const unsigned char* const png, const size_t pngsize) {
 			image[i] /= 2;
 	}
 
-	const size_t bytes_written = fwrite(image, 1, bytes_to_write, fp);
-	if (bytes_written != bytes_to_write) {
-		fprintf(stderr, "[ERROR] wasn't able to write bytes: %lu of %lu\n", bytes_written, bytes_to_write);
-		return EXIT_FAILURE;
-	}
+	return write_bin(filename_output, width, height, image, bytes_to_write);
+}
 
-	return 0;
+static int64_t mtime_ns(const struct stat* const st) {
+#ifdef __APPLE__
+	return (int64_t)st->st_mtimespec.tv_sec*1000000000 + st->st_mtimespec.tv_nsec;
+#else
+	return (int64_t)st->st_mtim.tv_sec*1000000000 + st->st_mtim.tv_nsec;
+#endif
 }
 
-int main (const int argc, const char* argv[]) {
-	if (flags(&g_cfg, argc, argv)) {
-		return EXIT_FAILURE;
-	}
+/* OUTPUT is up to date when it's newer than both INPUT and png2bin itself */
+static int up_to_date(const char* const filename_input, const char* const filename_output) {
+	struct stat st_in, st_out, st_tool;
+	if (g_cfg.force || stat(filename_output, &st_out) || stat(filename_input, &st_in))
+		return 0;
+	if (mtime_ns(&st_out) <= mtime_ns(&st_in))
+		return 0;
+	if (stat(g_cfg.tool_path, &st_tool) == 0 && mtime_ns(&st_out) <= mtime_ns(&st_tool))
+		return 0;
+	return 1;
+}
+
+static int convert(const char* const filename_input, const char* const filename_output) {
+	if (up_to_date(filename_input, filename_output))
+		return 0;
 
 	/* Read PNG */
 	unsigned char* png = NULL;
 	size_t pngsize;
-	unsigned error = lodepng_load_file(&png, &pngsize, g_cfg.filename_input);
+	unsigned error = lodepng_load_file(&png, &pngsize, filename_input);
 	if (error) {
-		fprintf(stderr, "[ERROR] %u: %s\n", error, lodepng_error_text(error));
+		fprintf(stderr, "[ERROR] %s %u: %s\n", filename_input, error, lodepng_error_text(error));
 		return EXIT_FAILURE;
 	}
 
+	int ret;
 	switch (g_cfg.mode) {
 		case MODE_BASIC:
-			if (palette_mode(png, pngsize))
-				return EXIT_FAILURE;
+			ret = palette_mode(png, pngsize, filename_input, filename_output);
 			break;
 		case MODE_RGB:
-			if (rgb_mode(png, pngsize))
-				return EXIT_FAILURE;
+			ret = rgb_mode(png, pngsize, filename_input, filename_output);
 			break;
 		case MODE_GRAY:
-			if (gray_mode(png, pngsize))
-				return EXIT_FAILURE;
+			ret = gray_mode(png, pngsize, filename_input, filename_output);
 			break;
 		default:
 			fprintf(stderr, "[ERROR] BAD MODE: %u\n", g_cfg.mode);
-			return EXIT_FAILURE;
+			ret = EXIT_FAILURE;
+			break;
+	}
+	free(png);
+
+	return ret;
+}
+
+/* Workers pull the next INPUT OUTPUT pair until the list runs out */
+static void* convert_thread(void* arg) {
+	(void)arg;
+	for (int i=atomic_fetch_add(&g_next_file, 1); i<g_cfg.file_cnt; i=atomic_fetch_add(&g_next_file, 1)) {
+		if (convert(g_cfg.filename_input[i*2], g_cfg.filename_output[i*2]))
+			atomic_store(&g_failed, 1);
+	}
+	return NULL;
+}
+
+int main (const int argc, const char* argv[]) {
+	if (flags(&g_cfg, argc, argv)) {
+		return EXIT_FAILURE;
+	}
+
+	int thread_cnt = g_cfg.thread_cnt;
+	if (thread_cnt <= 0)
+		thread_cnt = sysconf(_SC_NPROCESSORS_ONLN);
+	if (thread_cnt > g_cfg.file_cnt)
+		thread_cnt = g_cfg.file_cnt;
+	if (thread_cnt < 1)
+		thread_cnt = 1;
+
+	/* main thread is worker 0 */
+	pthread_t threads[thread_cnt];
+	int spawned = 1;
+	for (; spawned<thread_cnt; spawned++) {
+		if (pthread_create(&threads[spawned], NULL, convert_thread, NULL))
+			break;
 	}
+	convert_thread(NULL);
+	for (int i=1; i<spawned; i++)
+		pthread_join(threads[i], NULL);
 
-	return EXIT_SUCCESS;
+	return atomic_load(&g_failed) ? EXIT_FAILURE : EXIT_SUCCESS;
 }
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "planar.h"
+
+/* Host side stand-in for TempleOS' VGA window, map mask selects the plane written */
+typedef struct {
+	uint8_t mem[VGA_PLANE_CNT][VGA_PLANE_BYTES];
+	size_t port_writes;
+	size_t bytes_written;
+} fake_vga_t;
+
+static void vga_write(fake_vga_t* const vga, const int plane, const size_t idx, const uint8_t* const src, const size_t len) {
+	memcpy(&vga->mem[plane][idx], src, len);
+	vga->bytes_written += len;
+}
+
+/* The old write_vga: rebuild every plane bit by bit, then upload every row of every plane */
+static void present_ref(fake_vga_t* const vga, const uint8_t* const fb, const int interlace) {
+	static uint8_t plane_cache[VGA_PLANE_CNT*VGA_PLANE_BYTES];
+	memset(plane_cache, 0, sizeof(plane_cache));
+	for (int plane=0; plane<VGA_PLANE_CNT; plane++) {
+		uint8_t* pplane = &plane_cache[plane*VGA_PLANE_BYTES];
+		for (int y=0; y<VGA_H; y++) {
+			for (int x=0; x<VGA_ROW_BYTES; x++, pplane++) {
+				for (int i=0; i<8; i++) {
+					*pplane |= ((fb[y*VGA_W+x*8+i]&(1u<<plane)) >>(plane)) <<(7-i);
+				}
+			}
+		}
+	}
+	for (int y=0; y<VGA_H; y++) {
+		if ((y+interlace) % 2) continue;
+		for (int plane=0; plane<VGA_PLANE_CNT; plane++) {
+			vga->port_writes += 2;
+			vga_write(vga, plane, y*VGA_ROW_BYTES, &plane_cache[plane*VGA_PLANE_BYTES+y*VGA_ROW_BYTES], VGA_ROW_BYTES);
+		}
+	}
+}
+
+/* Mirrors write_vga in src/tosfb.c */
+static void present_new(fake_vga_t* const vga, vga_planar_t* const vp, const uint8_t* const fb, const int interlace) {
+	const uint32_t dirty_cnt = vga_planar_update(vp, fb, interlace);
+	if (!dirty_cnt)
+		return;
+	for (int plane=0; plane<VGA_PLANE_CNT; plane++) {
+		vga->port_writes += 2;
+		for (uint32_t i=0; i<dirty_cnt; i++) {
+			const int y = vp->dirty_rows[i];
+			const vga_span_t span = vp->spans[y];
+			const size_t idx = y*VGA_ROW_BYTES+span.x1;
+			vga_write(vga, plane, idx, &vp->planes[plane][idx], span.x2-span.x1);
+		}
+	}
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+/* Without a recording, fake a game frame: mostly static scene, a moving block and a changing statusline */
+static uint8_t* synth_frames(const size_t cnt) {
+	uint8_t* const frames = malloc(cnt*VGA_W*VGA_H);
+	if (!frames)
+		return NULL;
+	uint32_t seed = 42;
+	for (size_t f=0; f<cnt; f++) {
+		uint8_t* const fb = &frames[f*VGA_W*VGA_H];
+		for (int y=0; y<VGA_H; y++) {
+			for (int x=0; x<VGA_W; x++) {
+				fb[y*VGA_W+x] = ((x>>5)+(y>>5))&15;
+			}
+		}
+		const int bx = (f*7)%(VGA_W-128);
+		const int by = (f*3)%(VGA_H-128);
+		for (int y=by; y<by+128; y++) {
+			for (int x=bx; x<bx+128; x++) {
+				seed = seed*1664525u+1013904223u;
+				fb[y*VGA_W+x] = seed>>28;
+			}
+		}
+		for (int y=VGA_H-8; y<VGA_H; y++) {
+			for (int x=0; x<64; x++)
+				fb[y*VGA_W+x] = (f+x)&15;
+		}
+	}
+	return frames;
+}
+
+static uint8_t* read_frames(const char* const filename, size_t* const cnt) {
+	FILE* const fp = fopen(filename, "rb");
+	if (!fp) {
+		fprintf(stderr, "[ERROR] can't open %s\n", filename);
+		return NULL;
+	}
+	fseek(fp, 0, SEEK_END);
+	const long sz = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	*cnt = sz/(VGA_W*VGA_H);
+	if (*cnt == 0) {
+		fprintf(stderr, "[ERROR] %s holds no %dx%d frames\n", filename, VGA_W, VGA_H);
+		fclose(fp);
+		return NULL;
+	}
+	uint8_t* const frames = malloc(*cnt*VGA_W*VGA_H);
+	if (!frames || fread(frames, VGA_W*VGA_H, *cnt, fp) != *cnt) {
+		fprintf(stderr, "[ERROR] can't read %s\n", filename);
+		free(frames);
+		fclose(fp);
+		return NULL;
+	}
+	fclose(fp);
+	for (size_t i=0; i<*cnt*VGA_W*VGA_H; i++)
+		frames[i] &= 15;
+	return frames;
+}
+
+int main(const int argc, const char* argv[]) {
+	const char* helpStr = "vgabench [OPTIONS] [FRAMES]\n"
+		"  -n  passes over the frame set (default 10)\n"
+		"FRAMES is raw 640x480 8bpp framebuffers back to back, as written by cyberchud-bin -fbdump\n";
+
+	int passes = 10;
+	const char* filename = NULL;
+	for (int i=1; i<argc; i++) {
+		if (strcmp(argv[i], "-n")==0 && i+1<argc) {
+			passes = atoi(argv[++i]);
+		} else if (*argv[i] == '-') {
+			fprintf(stderr, "%s", helpStr);
+			return 1;
+		} else {
+			filename = argv[i];
+		}
+	}
+
+	size_t frame_cnt = 240;
+	uint8_t* const frames = filename ? read_frames(filename, &frame_cnt) : synth_frames(frame_cnt);
+	if (!frames)
+		return EXIT_FAILURE;
+
+	static fake_vga_t vga_ref;
+	static fake_vga_t vga_new;
+	static vga_planar_t vp;
+	vga_planar_init(&vp);
+
+	double t_ref = 0;
+	double t_new = 0;
+	size_t presents = 0;
+	for (int p=0; p<passes; p++) {
+		for (size_t f=0; f<frame_cnt; f++, presents++) {
+			const uint8_t* const fb = &frames[f*VGA_W*VGA_H];
+			const int interlace = presents&1;
+
+			double start = now();
+			present_ref(&vga_ref, fb, interlace);
+			t_ref += now()-start;
+
+			start = now();
+			present_new(&vga_new, &vp, fb, interlace);
+			t_new += now()-start;
+
+			if (memcmp(vga_ref.mem, vga_new.mem, sizeof(vga_ref.mem))) {
+				fprintf(stderr, "[ERROR] VGA memory mismatch at frame %zu\n", f);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	printf("frames:%zu presents:%zu\n", frame_cnt, presents);
+	printf("ref: %8.1f us/present %8.0f bytes/present %6.1f port writes/present\n", t_ref*1e6/presents, (double)vga_ref.bytes_written/presents, (double)vga_ref.port_writes/presents);
+	printf("new: %8.1f us/present %8.0f bytes/present %6.1f port writes/present\n", t_new*1e6/presents, (double)vga_new.bytes_written/presents, (double)vga_new.port_writes/presents);
+	printf("speedup: %.1fx\n", t_ref/t_new);
+
+	free(frames);
+	return 0;
+}
@@ -6,7 +6,12 @@
 
 int flags(cfg_t *cfg, const int argc, const char *argv[]) {
 	const char* helpStr = "wadmaker [OPTIONS] [INPUT ...] [OUTPUT WAD] [OUTPUT HEADER]\n"
-		"  -s  Skeleton Mode\n";
+		"  -g  Glob Mode\n"
+		"  -r  Compression Ratio\n"
+		"  -c  Compression Level\n"
+		"  -d  Working Directory\n"
+		"  -j  Thread Count (default: CPU count)\n"
+		"  -f  Force, recompress every lump instead of reusing OUTPUT WAD.manifest\n";
 
 	/* Defaults */
 	cfg->mode = MODE_BASIC;
@@ -28,6 +33,11 @@ int flags(cfg_t *cfg, const int argc, const char *argv[]) {
 			} else if (strcmp(argv[i], "-d")==0) { // PWD
 				cfg->flagCount++;
 				cfg->pwd_dir = argv[++i];
+			} else if (strcmp(argv[i], "-j")==0) {
+				cfg->flagCount++;
+				cfg->thread_cnt = atoi(argv[++i]);
+			} else if (strcmp(argv[i], "-f")==0) {
+				cfg->force = 1;
 			} else if (strcmp(argv[i], "-b")==0) {
 				cfg->flagCount++;
 				cfg->blocksize = strtoul(argv[++i], NULL, 10);
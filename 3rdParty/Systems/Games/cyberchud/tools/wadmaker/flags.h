@@ -13,6 +13,8 @@ typedef enum {
 typedef struct {
 	int flagCount;
 	int compression_level;
+	int thread_cnt;
+	int force; // ignore the manifest
 	float compression_ratio;
 	size_t blocksize;
 	MODE mode;
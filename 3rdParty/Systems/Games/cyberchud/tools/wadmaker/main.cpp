@@ -1,7 +1,11 @@
 #include <ctype.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <atomic>
 #include <filesystem>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 #include "flags.h"
 #include "common.h"
@@ -22,6 +26,11 @@ static const category_settings_t CATEGORIES[CATEGORY_CNT] = {
 	{"snd/", 0},
 };
 
+/* Text file next to the WAD: one line per lump with its content hash and where its bytes sit in the WAD.
+ * Lumps whose hash still matches are copied from the old WAD as is instead of being recompressed. */
+#define MANIFEST_MAGIC "wadmaker-manifest"
+#define MANIFEST_VERSION 1
+
 cfg_t g_cfg;
 
 typedef struct {
@@ -30,11 +39,26 @@ typedef struct {
 	uint64_t compressed_size;
 	uint64_t str_pos;
 	uint32_t flags;
+	uint64_t hash;
 
 	const char* raw_path;
 	std::filesystem::path relative_path;
+	std::vector<char> data; // bytes that go in the WAD, compressed or not
+	int reused;
 } file_header_t;
 
+typedef struct {
+	uint64_t hash;
+	uint64_t pos;
+	uint64_t size;
+	uint64_t compressed_size;
+} manifest_entry_t;
+
+typedef struct {
+	std::unordered_map<std::string, manifest_entry_t> entries;
+	std::vector<char> wad; // previous WAD, lumps get copied out of it
+} manifest_t;
+
 typedef struct {
 	uint32_t idx;
 	char name[128];
@@ -67,14 +91,38 @@ static inline void* malloc_orDie(size_t size) {
 	exit(ERROR_malloc);
 }
 
-static size_t compress_guess(FILE* fout, file_header_t *header) {
-	const size_t cBuffSize = ZSTD_compressBound(header->size);
-	void* const cBuff = malloc_orDie(cBuffSize);
+static int skip_padding(uintptr_t reader) {
+	int align_mod = reader%16;
+	if (align_mod != 0) {
+		align_mod = 16-align_mod;
+#ifndef NDEBUG
+		printf("[skip_padding] skipping: %d %lu\n", align_mod, reader);
+#endif
+	}
+	return align_mod;
+}
 
-	FILE* const fin = fopen_orDie(header->raw_path, "rb");
-	char* read_buffer = (char*)malloc(header->size);
-	fread(read_buffer, 1, header->size, fin);
-	size_t const cSize = ZSTD_compress(cBuff, cBuffSize, read_buffer, header->size, g_cfg.compression_level);
+static uint64_t fnv1a64(const char* const data, const size_t size) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (size_t i=0; i<size; i++) {
+		hash ^= static_cast<uint8_t>(data[i]);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+static int read_file(const char* const path, std::vector<char>& out, const size_t size) {
+	FILE* const fin = fopen_orDie(path, "rb");
+	out.resize(size);
+	const size_t read = fread(out.data(), 1, size, fin);
+	fclose(fin);
+	return read != size;
+}
+
+static void compress_guess(ZSTD_CCtx* const cctx, file_header_t *header, std::vector<char>& raw) {
+	const size_t cBuffSize = ZSTD_compressBound(header->size);
+	header->data.resize(cBuffSize);
+	size_t const cSize = ZSTD_compressCCtx(cctx, header->data.data(), cBuffSize, raw.data(), header->size, g_cfg.compression_level);
 	CHECK_ZSTD(cSize);
 
 #ifndef NDEBUG
@@ -82,24 +130,117 @@ static size_t compress_guess(FILE* fout, file_header_t *header) {
 #endif
 	if (static_cast<float>(cSize) / static_cast<float>(header->size) <= g_cfg.compression_ratio) {
 		header->compressed_size = cSize;
-		fwrite(cBuff, 1, cSize, fout);
-		return header->compressed_size;
+		header->data.resize(cSize);
 	} else {
 		header->compressed_size = 0;
-		fwrite(read_buffer, 1, header->size, fout);
-		return header->size;
+		header->data.swap(raw);
 	}
 }
 
-static int skip_padding(uintptr_t reader) {
-	int align_mod = reader%16;
-	if (align_mod != 0) {
-		align_mod = 16-align_mod;
-#ifndef NDEBUG
-		printf("[skip_padding] skipping: %d %lu\n", align_mod, reader);
-#endif
+/* Reuses the old WAD's bytes when the lump's content hash is unchanged, compresses it otherwise */
+static void build_lump(ZSTD_CCtx* const cctx, const manifest_t& manifest, file_header_t *header) {
+	std::vector<char> raw;
+	CHECK(read_file(header->raw_path, raw, header->size) == 0, "can't read %s", header->raw_path);
+	header->hash = fnv1a64(raw.data(), raw.size());
+
+	const auto it = manifest.entries.find(header->relative_path.string());
+	if (it != manifest.entries.end()) {
+		const manifest_entry_t& entry = it->second;
+		const uint64_t stored = entry.compressed_size ? entry.compressed_size : entry.size;
+		if (entry.hash == header->hash && entry.size == header->size && entry.pos+stored <= manifest.wad.size()) {
+			header->compressed_size = entry.compressed_size;
+			header->data.assign(manifest.wad.begin()+entry.pos, manifest.wad.begin()+entry.pos+stored);
+			header->reused = 1;
+			return;
+		}
 	}
-	return align_mod;
+
+	compress_guess(cctx, header, raw);
+}
+
+static void build_lumps(header_t& header, const manifest_t& manifest, const int thread_cnt) {
+	std::atomic<size_t> next{0};
+	auto worker = [&]() {
+		ZSTD_CCtx* const cctx = ZSTD_createCCtx();
+		CHECK(cctx != NULL, "ZSTD_createCCtx() failed!");
+		for (size_t i=next++; i<header.file_headers.size(); i=next++) {
+			build_lump(cctx, manifest, &header.file_headers[i]);
+		}
+		ZSTD_freeCCtx(cctx);
+	};
+
+	/* main thread is worker 0 */
+	std::vector<std::thread> threads;
+	for (int i=1; i<thread_cnt; i++)
+		threads.emplace_back(worker);
+	worker();
+	for (auto& thread : threads)
+		thread.join();
+}
+
+static size_t write_lump(FILE* fout, const file_header_t *header) {
+	const size_t written = header->data.size();
+	fwrite(header->data.data(), 1, written, fout);
+
+	/* keep every lump 16 byte aligned so the engine can use uncompressed lumps in place */
+	const size_t align_mod = skip_padding(header->pos+written);
+	static const char zeros[16] = {0};
+	fwrite(zeros, 1, align_mod, fout);
+	return written+align_mod;
+}
+
+static std::string manifest_path() {
+	return g_cfg.filename_output.string() + ".manifest";
+}
+
+/* Any mismatch (settings, WAD size, parse error) just means nothing gets reused */
+static void manifest_load(manifest_t& manifest) {
+	FILE* const fp = fopen(manifest_path().c_str(), "r");
+	if (fp == NULL)
+		return;
+
+	char magic[32];
+	int version, level;
+	float ratio;
+	unsigned long long wad_size;
+	if (fscanf(fp, "%31s %d %d %f %llu\n", magic, &version, &level, &ratio, &wad_size) != 5
+		|| strcmp(magic, MANIFEST_MAGIC) != 0
+		|| version != MANIFEST_VERSION
+		|| level != g_cfg.compression_level
+		|| ratio != g_cfg.compression_ratio) {
+		fclose(fp);
+		return;
+	}
+
+	std::unordered_map<std::string, manifest_entry_t> entries;
+	unsigned long long hash, pos, size, csize;
+	char path[4096];
+	while (fscanf(fp, "%llx %llu %llu %llu ", &hash, &pos, &size, &csize) == 4 && fgets(path, sizeof(path), fp)) {
+		path[strcspn(path, "\n")] = '\0';
+		entries[path] = manifest_entry_t{hash, pos, size, csize};
+	}
+	fclose(fp);
+
+	FILE* const fwad = fopen(g_cfg.filename_output.c_str(), "rb");
+	if (fwad == NULL)
+		return;
+	fseek(fwad, 0L, SEEK_END);
+	if (static_cast<unsigned long long>(ftell(fwad)) == wad_size) {
+		manifest.wad.resize(wad_size);
+		fseek(fwad, 0L, SEEK_SET);
+		if (fread(manifest.wad.data(), 1, wad_size, fwad) == wad_size)
+			manifest.entries.swap(entries);
+	}
+	fclose(fwad);
+}
+
+static void manifest_write(const header_t& header) {
+	FILE* const fp = fopen_orDie(manifest_path().c_str(), "w");
+	fprintf(fp, "%s %d %d %.9g %lu\n", MANIFEST_MAGIC, MANIFEST_VERSION, g_cfg.compression_level, g_cfg.compression_ratio, header.pos);
+	for (const auto& file : header.file_headers) {
+		fprintf(fp, "%016lx %lu %lu %lu %s\n", file.hash, file.pos, file.size, file.compressed_size, file.relative_path.c_str());
+	}
+	fclose(fp);
 }
 
 static size_t glob_write(std::vector<char>& out, file_header_t *header) {
@@ -119,7 +260,7 @@ static size_t glob_write(std::vector<char>& out, file_header_t *header) {
 	return aligned_pos;
 }
 
-void glob_mode(FILE* writer, header_t& header) {
+void glob_mode(FILE* writer, header_t& header, const int thread_cnt) {
 	uint64_t total_glob_size = 0;
 	for (auto& file_header : header.file_headers) {
 		total_glob_size += file_header.size;
@@ -134,8 +275,14 @@ void glob_mode(FILE* writer, header_t& header) {
 	const size_t cBuffSize = ZSTD_compressBound(buffer.size());
 	void* const cBuff = malloc_orDie(cBuffSize);
 
-	size_t const cSize = ZSTD_compress(cBuff, cBuffSize, buffer.data(), buffer.size(), g_cfg.compression_level);
+	/* one frame for everything, so let zstd split it across threads */
+	ZSTD_CCtx* const cctx = ZSTD_createCCtx();
+	CHECK(cctx != NULL, "ZSTD_createCCtx() failed!");
+	CHECK_ZSTD(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, g_cfg.compression_level));
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, thread_cnt > 1 ? thread_cnt : 0);
+	size_t const cSize = ZSTD_compress2(cctx, cBuff, cBuffSize, buffer.data(), buffer.size());
 	CHECK_ZSTD(cSize);
+	ZSTD_freeCCtx(cctx);
 	fwrite(cBuff, 1, cSize, writer);
 
 	header.size = buffer.size();
@@ -167,7 +314,7 @@ int write_header_file(header_t *header, const char* path) {
 	if (fseek(reader, 0L, SEEK_END) == -1) {
 		return EXIT_FAILURE;
 	}
-	file_header_t file_header;
+	file_header_t file_header{};
 	file_header.size = ftell(reader);
 	if (fclose(reader) != 0) {
 		return EXIT_FAILURE;
@@ -211,10 +358,14 @@ int write_c_header(const header_t* header) {
 	char filename_upper[512] = {0}; // TODO leaky
 	FILE* fp_header = fopen_orDie(g_cfg.header_filename, "w");
 	size_t size_max = 0;
+	size_t heap_size = g_cfg.mode == MODE_GLOB ? header->size : 0;
 	for (size_t i=0; i<header->file_headers.size(); i++) {
 		const file_header_t *file_header = &header->file_headers[i];
 		if (file_header->size > size_max)
 			size_max = file_header->size;
+		/* compressed lumps get decompressed into one 16 byte aligned heap */
+		if (file_header->compressed_size)
+			heap_size += file_header->size + skip_padding(file_header->size);
 		upper_str(filename_upper, file_header->raw_path);
 #ifndef NDEBUG
 		printf("[write_c_header] [%lu] %s %s pos:%lu size:%lu csize:%lu\n", i, file_header->raw_path, filename_upper, file_header->pos, file_header->size, file_header->compressed_size);
@@ -235,10 +386,21 @@ int write_c_header(const header_t* header) {
 "	const char* filename;\n" // TMP
 "} file_header_t;\n\n"
 "typedef struct {\n"
-"	FILE* fp;\n"
-"	size_t buff_in_size;\n"
-"	void* buff_in;\n"
-"	ZSTD_DCtx* dctx;\n"
+"	const char* file_data; // whole WAD, mapped or read in\n"
+"	size_t file_size;\n"
+"	int mapped;\n"
+"	int error;\n"
+"	char* heap; // decompressed lumps\n"
+"	const char** lumps;\n"
+"	volatile uint8_t* ready;\n"
+"	const uint32_t* queue; // lumps for the worker threads\n"
+"	uint32_t queue_cnt;\n"
+"	uint32_t queue_pos;\n"
+"	uint32_t* stream; // lumps for the background thread\n"
+"	uint32_t stream_cnt;\n"
+"	void* stream_thread;\n"
+"	void* mutex;\n"
+"	void* cond;\n"
 "} wad_t;\n\n"
 "typedef enum {\n");
 
@@ -262,15 +424,20 @@ int write_c_header(const header_t* header) {
 
 	fprintf(fp_header,
 "int wad_init(wad_t* const arc, const char* filename);\n"
-"int wad_get(const wad_t* const arc, const WAD_IDX idx, char* data);\n"
-"int wad_get_malloc(const wad_t* const arc, const WAD_IDX idx, char** data);\n"
-"int wad_get_glob(const wad_t* const arc, char* data);\n"
+"const char* wad_lump(const wad_t* const arc, const WAD_IDX idx);\n"
+"ZSTD_DCtx* wad_dctx_create(void);\n"
+"void wad_queue(wad_t* const arc, const uint32_t* const idxs, const uint32_t cnt);\n"
+"int wad_decompress_queue(wad_t* const arc, ZSTD_DCtx* const dctx);\n"
+"int wad_stream(wad_t* const arc, const uint32_t* const idxs, const uint32_t cnt);\n"
+"int wad_wait(wad_t* const arc, const WAD_IDX idx);\n"
 "void wad_free(wad_t* const arc);\n\n"
 "#define WAD_TOTAL %lu\n"
 "#define WAD_SIZE_MAX %lu\n"
+"#define WAD_GLOB %d\n"
 "#define WAD_GLOB_SIZE %lu\n"
 "#define WAD_GLOB_SIZE_ZSTD %lu\n"
-"extern const file_header_t g_wad[WAD_TOTAL];\n", header->file_headers.size(), size_max, header->size, header->size_compressed);
+"#define WAD_HEAP_SIZE %lu\n"
+"extern const file_header_t g_wad[WAD_TOTAL];\n", header->file_headers.size(), size_max, g_cfg.mode == MODE_GLOB, header->size, header->size_compressed, heap_size);
 	for (int ci=0; ci<CATEGORY_CNT; ci++) {
 		upper_str(filename_upper, CATEGORIES[ci].path);
 		fprintf(fp_header, "extern const uint32_t %sFILES[%sTOTAL];\n", filename_upper, filename_upper);
@@ -312,8 +479,11 @@ int write_c_header(const header_t* header) {
 }
 
 int main(const int argc, const char *argv[]) {
+	std::error_code ec;
 	header_t header;
 	header.pos = 0;
+	header.size = 0;
+	header.size_compressed = 0;
 
 	if (flags(&g_cfg, argc, argv)) {
 		fprintf(stderr, "[ERR] flags error\n");
@@ -335,20 +505,51 @@ int main(const int argc, const char *argv[]) {
 		}
 	}
 
-	FILE* writer = fopen(g_cfg.filename_output.c_str(), "wb");
+	int thread_cnt = g_cfg.thread_cnt;
+	if (thread_cnt <= 0)
+		thread_cnt = std::thread::hardware_concurrency();
+	if (thread_cnt <= 0)
+		thread_cnt = 1;
+
+	/* the old WAD is read in before it gets truncated, and the stale manifest goes before anything is written */
+	manifest_t manifest;
+	if (g_cfg.mode == MODE_BASIC && !g_cfg.force)
+		manifest_load(manifest);
+	std::filesystem::remove(manifest_path(), ec);
+
+	switch (g_cfg.mode) {
+		case MODE_BASIC:
+			build_lumps(header, manifest, thread_cnt);
+			manifest.wad.clear();
+			break;
+		case MODE_GLOB:
+			break;
+	}
+
+	FILE* writer = fopen_orDie(g_cfg.filename_output.c_str(), "wb");
+	size_t reused = 0;
 	switch (g_cfg.mode) {
 		case MODE_BASIC:
 			for (auto& file_header : header.file_headers) {
 				file_header.pos = header.pos;
-				header.pos += compress_guess(writer, &file_header);
+				header.pos += write_lump(writer, &file_header);
+				reused += file_header.reused;
 			}
 			break;
 		case MODE_GLOB:
-			glob_mode(writer, header);
+			glob_mode(writer, header, thread_cnt);
 			break;
 	}
 
-	fclose(writer);
+	if (fclose(writer) != 0) {
+		fprintf(stderr, "[ERR] can't write %s\n", g_cfg.filename_output.c_str());
+		return 1;
+	}
+
+	if (g_cfg.mode == MODE_BASIC) {
+		manifest_write(header);
+		printf("[wadmaker] %zu lumps, %zu reused, %zu compressed on %d threads\n", header.file_headers.size(), reused, header.file_headers.size()-reused, thread_cnt);
+	}
 
 	if (write_c_header(&header)) {
 		return 1;
@@ -7,6 +7,6 @@ loader/build.sh frotz.prg frotz/src/frotz_common.a frotz/src/frotz_dumb.a
 
 cp ~/Downloads/vgame.z8 . || true
 genisoimage -o demo.iso -r -J \
-    TempleLoader.CPP Frotz.CPP *.z8 *.z5 frotz.prg README*
+    TempleLoader.CPP Frotz.CPP IOBench.CPP *.z8 *.z5 frotz.prg README*
 
 
@@ -84,7 +84,9 @@ static FILE *story_fp = NULL;
  * Data for the undo mechanism.
  * This undo mechanism is based on the scheme used in Evin Robertson's
  * Nitfol interpreter.
- * Undo blocks are stored as differences between states.
+ * Undo blocks are stored as differences between states. Pages that
+ * were not written since the last snapshot are known to be equal and
+ * aren't compared, they cost nothing in the blocks either.
  */
 
 typedef struct undo_struct undo_t;
@@ -104,6 +106,11 @@ static zbyte *undo_mem = NULL, *prev_zmp, *undo_diff;
 
 static int undo_count = 0;
 
+zbyte undo_dirty[UNDO_PAGES];
+
+zbyte dict_page[UNDO_PAGES];
+unsigned long dict_writes = 0;
+
 
 /*
  * get_header_extension
@@ -408,6 +415,7 @@ void init_undo (void)
 	prev_zmp = undo_mem;
 	undo_diff = undo_mem + h_dynamic_size;
 	memcpy (prev_zmp, zmp, h_dynamic_size);
+	memset (undo_dirty, 0, sizeof (undo_dirty));
     } else
 	f_setup.undo_slots = 0;
 
@@ -478,9 +486,14 @@ void reset_memory (void)
  */
 void storeb (zword addr, zbyte value)
 {
-    if (addr >= h_dynamic_size)
+    if (addr >= h_dynamic_size) {
 	runtime_error (ERR_STORE_RANGE);
 
+	/* The store still happens if errors are ignored */
+
+	flush_dictionaries ();
+    }
+
     if (addr == H_FLAGS + 1) {	/* flags register is modified */
 
 	h_flags &= ~(SCRIPTING_FLAG | FIXED_FONT_FLAG);
@@ -539,6 +552,8 @@ void z_restart (void)
 
 	if (fread (zmp, 1, h_dynamic_size, story_fp) != h_dynamic_size)
 	    os_fatal ("Story file read error");
+	memset (undo_dirty, 1, sizeof (undo_dirty));
+	dict_writes++;
 
     } else first_restart = FALSE;
 
@@ -636,6 +651,8 @@ void z_restore (void)
 	/* Load auxilary file */
 
 	success = fread (zmp + zargs[0], 1, zargs[1], gfp);
+	memset (undo_dirty, 1, sizeof (undo_dirty));
+	dict_writes++;
 
 	/* Close auxilary file */
 
@@ -661,6 +678,8 @@ void z_restore (void)
 	    goto finished;
 
 	success = restore_quetzal (gfp, story_fp);
+	memset (undo_dirty, 1, sizeof (undo_dirty));
+	dict_writes++;
 
 	if ((short) success >= 0) {
 
@@ -713,6 +732,7 @@ finished:
  * copying a to b as we go.  It is assumed that diff points to a
  * buffer which is large enough to hold the diff.
  * mem_size is the number of bytes to compare.
+ * Only pages marked in undo_dirty are compared, the marks are cleared.
  * Returns the number of bytes copied to diff.
  *
  */
@@ -720,33 +740,46 @@ static long mem_diff (zbyte *a, zbyte *b, zword mem_size, zbyte *diff)
 {
     unsigned size = mem_size;
     zbyte *p = diff;
-    unsigned j;
+    unsigned i, j, end;
     zbyte c;
 
-    for (;;) {
-	for (j = 0; size > 0 && (c = *a++ ^ *b++) == 0; j++)
-	    size--;
-	if (size == 0) break;
-	size--;
-	if (j > 0x8000) {
-	    *p++ = 0;
-	    *p++ = 0xff;
-	    *p++ = 0xff;
-	    j -= 0x8000;
+    j = 0;
+    for (i = 0; i < size; i = end) {
+	end = (i | (UNDO_PAGE_SIZE - 1)) + 1;
+	if (end > size)
+	    end = size;
+	if (!undo_dirty[i >> UNDO_PAGE_SHIFT]
+	    || memcmp (a + i, b + i, end - i) == 0) {
+	    j += end - i;
+	    continue;
 	}
-	if (j > 0) {
-	    *p++ = 0;
-	    j--;
-	    if (j <= 0x7f) {
-		*p++ = j;
-	    } else {
-		*p++ = (j & 0x7f) | 0x80;
-		*p++ = (j & 0x7f80) >> 7;
+	for (; i < end; i++) {
+	    if ((c = a[i] ^ b[i]) == 0) {
+		j++;
+		continue;
+	    }
+	    if (j > 0x8000) {
+		*p++ = 0;
+		*p++ = 0xff;
+		*p++ = 0xff;
+		j -= 0x8000;
 	    }
+	    if (j > 0) {
+		*p++ = 0;
+		j--;
+		if (j <= 0x7f) {
+		    *p++ = j;
+		} else {
+		    *p++ = (j & 0x7f) | 0x80;
+		    *p++ = (j & 0x7f80) >> 7;
+		}
+	    }
+	    *p++ = c;
+	    b[i] ^= c;
+	    j = 0;
 	}
-	*p++ = c;
-	*(b - 1) ^= c;
     }
+    memset (undo_dirty, 0, sizeof (undo_dirty));
     return p - diff;
 }/* mem_diff */
 
@@ -754,11 +787,13 @@ static long mem_diff (zbyte *a, zbyte *b, zword mem_size, zbyte *diff)
 /*
  * mem_undiff
  *
- * Applies a quetzal-like diff to dest
+ * Applies a quetzal-like diff to dest, marking the pages it changes
+ * in undo_dirty.
  *
  */
 static void mem_undiff (zbyte *diff, long diff_length, zbyte *dest)
 {
+    zbyte *start = dest;
     zbyte c;
 
     while (diff_length) {
@@ -781,6 +816,7 @@ static void mem_undiff (zbyte *diff, long diff_length, zbyte *dest)
 
 	    dest += runlen + 1;
 	} else {
+	    undo_dirty[(dest - start) >> UNDO_PAGE_SHIFT] = 1;
 	    *dest++ ^= c;
 	}
     }
@@ -796,6 +832,7 @@ static void mem_undiff (zbyte *diff, long diff_length, zbyte *dest)
 int restore_undo (void)
 {
     long pc = curr_undo->pc;
+    long i;
 
     if (f_setup.undo_slots == 0)	/* undo feature unavailable */
 
@@ -807,7 +844,12 @@ int restore_undo (void)
 
     /* undo possible */
 
-    memcpy (zmp, prev_zmp, h_dynamic_size);
+    for (i = 0; i < h_dynamic_size; i += UNDO_PAGE_SIZE)
+	if (undo_dirty[i >> UNDO_PAGE_SHIFT])
+	    memcpy (zmp + i, prev_zmp + i, (h_dynamic_size - i < UNDO_PAGE_SIZE) ?
+		    h_dynamic_size - i : UNDO_PAGE_SIZE);
+    memset (undo_dirty, 0, sizeof (undo_dirty));
+    dict_writes++;
     SET_PC (pc);
     sp = stack + STACK_SIZE - curr_undo->stack_size;
     fp = stack + curr_undo->frame_offset;
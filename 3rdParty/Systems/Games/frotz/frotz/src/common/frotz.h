@@ -315,7 +315,23 @@ typedef struct {
 
 /*** Data access macros ***/
 
-#define SET_BYTE(addr,v)  { zmp[addr] = v; }
+/* Writes mark their page in undo_dirty, save_undo only diffs those */
+
+#define UNDO_PAGE_SHIFT 6
+#define UNDO_PAGE_SIZE (1 << UNDO_PAGE_SHIFT)
+#define UNDO_PAGES (0x10000 >> UNDO_PAGE_SHIFT)
+
+extern zbyte undo_dirty[UNDO_PAGES];
+
+/* and count the ones that land on a dictionary kept in dynamic memory */
+
+extern zbyte dict_page[UNDO_PAGES];
+extern unsigned long dict_writes;
+
+#define SET_DIRTY(addr)   { undo_dirty[(zword) (addr) >> UNDO_PAGE_SHIFT] = 1; \
+			    dict_writes += dict_page[(zword) (addr) >> UNDO_PAGE_SHIFT]; }
+
+#define SET_BYTE(addr,v)  { zmp[addr] = v; SET_DIRTY (addr) }
 #define LOW_BYTE(addr,v)  { v = zmp[addr]; }
 #define CODE_BYTE(v)	  { v = *pcp++;    }
 
@@ -327,7 +343,8 @@ extern zbyte *zmp;
 #define lo(v)	((zbyte *)&v)[1]
 #define hi(v)	((zbyte *)&v)[0]
 
-#define SET_WORD(addr,v)  { zmp[addr] = hi(v); zmp[addr+1] = lo(v); }
+#define SET_WORD(addr,v)  { zmp[addr] = hi(v); zmp[addr+1] = lo(v); \
+			    SET_DIRTY (addr) SET_DIRTY ((addr) + 1) }
 #define LOW_WORD(addr,v)  { hi(v) = zmp[addr]; lo(v) = zmp[addr+1]; }
 #define HIGH_WORD(addr,v) { hi(v) = zmp[addr]; lo(v) = zmp[addr+1]; }
 #define CODE_WORD(v)      { hi(v) = *pcp++; lo(v) = *pcp++; }
@@ -343,12 +360,13 @@ extern zbyte *zmp;
 #define lo(v)   ((zbyte *)&v)[0]
 #define hi(v)   ((zbyte *)&v)[1]
 
-#define SET_WORD(addr,v) asm {\
+#define SET_WORD(addr,v) { asm {\
     les bx,zmp;\
     add bx,addr;\
     mov ax,v;\
     xchg al,ah;\
-    mov es:[bx],ax }
+    mov es:[bx],ax }\
+    SET_DIRTY (addr) SET_DIRTY ((addr) + 1) }
 
 #define LOW_WORD(addr,v) asm {\
     les bx,zmp;\
@@ -418,7 +436,8 @@ extern zbyte *zmp;
 #define lo(v)	(v & 0xff)
 #define hi(v)	(v >> 8)
 
-#define SET_WORD(addr,v)  { zmp[addr] = hi(v); zmp[addr+1] = lo(v); }
+#define SET_WORD(addr,v)  { zmp[addr] = hi(v); zmp[addr+1] = lo(v); \
+			    SET_DIRTY (addr) SET_DIRTY ((addr) + 1) }
 #define LOW_WORD(addr,v)  { v = ((zword) zmp[addr] << 8) | zmp[addr+1]; }
 #define HIGH_WORD(addr,v) { v = ((zword) zmp[addr] << 8) | zmp[addr+1]; }
 #define CODE_WORD(v)      { v = ((zword) pcp[0] << 8) | pcp[1]; pcp += 2; }
@@ -484,6 +503,9 @@ extern zword frame_count;
 extern zword zargs[8];
 extern int zargc;
 
+extern unsigned long instruction_count;
+extern bool count_instructions;
+
 extern bool ostream_screen;
 extern bool ostream_script;
 extern bool ostream_memory;
@@ -712,6 +734,8 @@ void 	branch (bool);
 void	storeb (zword, zbyte);
 void	storew (zword, zword);
 
+void	flush_dictionaries (void);
+
 
 	/*** returns the current window ***/
 Zwindow * curwinrec( void);
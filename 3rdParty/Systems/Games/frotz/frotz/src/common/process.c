@@ -28,6 +28,9 @@
 zword zargs[8];
 int zargc;
 
+unsigned long instruction_count = 0;
+bool count_instructions = FALSE;	/* set by dfrotz -B */
+
 static int finished = 0;
 
 static void __extended__ (void);
@@ -184,42 +187,29 @@ void init_process (void)
 
 
 /*
- * load_operand
- *
- * Load an operand, either a variable or a constant.
+ * Operand fetches, one for each operand type. The 2OP and 1OP forms
+ * give the types in the opcode itself, so interpret picks the right
+ * fetches for them once instead of testing the type of every operand.
  *
  */
-static void load_operand (zbyte type)
-{
-    zword value;
-
-    if (type & 2) { 			/* variable */
-
-	zbyte variable;
-
-	CODE_BYTE (variable)
-
-	if (variable == 0)
-	    value = *sp++;
-	else if (variable < 16)
-	    value = *(fp - variable);
-	else {
-	    zword addr = h_globals + 2 * (variable - 16);
-	    LOW_WORD (addr, value)
-	}
-
-    } else if (type & 1) { 		/* small constant */
-
-	zbyte bvalue;
-
-	CODE_BYTE (bvalue)
-	value = bvalue;
-
-    } else CODE_WORD (value) 		/* large constant */
-
-    zargs[zargc++] = value;
-
-}/* load_operand */
+#define LOAD_LARGE(v)	CODE_WORD (v)
+
+#define LOAD_SMALL(v)	{ zbyte bvalue; CODE_BYTE (bvalue) v = bvalue; }
+
+#define LOAD_VARIABLE(v) {				\
+    zbyte variable;					\
+							\
+    CODE_BYTE (variable)				\
+							\
+    if (variable == 0)					\
+	v = *sp++;					\
+    else if (variable < 16)				\
+	v = *(fp - variable);				\
+    else {						\
+	zword addr = h_globals + 2 * (variable - 16);	\
+	LOW_WORD (addr, v)				\
+    }							\
+}
 
 
 /*
@@ -235,12 +225,14 @@ static void load_all_operands (zbyte specifier)
 
     for (i = 6; i >= 0; i -= 2) {
 
-	zbyte type = (specifier >> i) & 0x03;
-
-	if (type == 3)
-	    break;
+	switch ((specifier >> i) & 0x03) {
+	case 0: LOAD_LARGE (zargs[zargc]) break;
+	case 1: LOAD_SMALL (zargs[zargc]) break;
+	case 2: LOAD_VARIABLE (zargs[zargc]) break;
+	default: return;
+	}
 
-	load_operand (type);
+	zargc++;
 
     }
 
@@ -260,20 +252,33 @@ void interpret (void)
 
 	zbyte opcode;
 
+	if (count_instructions)
+	    instruction_count++;
+
 	CODE_BYTE (opcode)
 
 	zargc = 0;
 
 	if (opcode < 0x80) {			/* 2OP opcodes */
 
-	    load_operand ((zbyte) (opcode & 0x40) ? 2 : 1);
-	    load_operand ((zbyte) (opcode & 0x20) ? 2 : 1);
+	    switch (opcode & 0x60) {		/* variables or small constants */
+	    case 0x00: LOAD_SMALL (zargs[0]) LOAD_SMALL (zargs[1]) break;
+	    case 0x20: LOAD_SMALL (zargs[0]) LOAD_VARIABLE (zargs[1]) break;
+	    case 0x40: LOAD_VARIABLE (zargs[0]) LOAD_SMALL (zargs[1]) break;
+	    default: LOAD_VARIABLE (zargs[0]) LOAD_VARIABLE (zargs[1]) break;
+	    }
+	    zargc = 2;
 
 	    var_opcodes[opcode & 0x1f] ();
 
 	} else if (opcode < 0xb0) {		/* 1OP opcodes */
 
-	    load_operand ((zbyte) (opcode >> 4));
+	    switch (opcode & 0x30) {
+	    case 0x00: LOAD_LARGE (zargs[0]) break;
+	    case 0x10: LOAD_SMALL (zargs[0]) break;
+	    default: LOAD_VARIABLE (zargs[0]) break;
+	    }
+	    zargc = 1;
 
 	    op1_opcodes[opcode & 0x0f] ();
 
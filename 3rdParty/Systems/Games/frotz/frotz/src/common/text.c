@@ -18,6 +18,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <stdlib.h>
+#include <string.h>
 #include "frotz.h"
 
 enum string_type {
@@ -29,6 +31,37 @@ extern zword object_name (zword);
 static zchar decoded[10];
 static zword encoded[3];
 
+/*
+ * Host side copies of the dictionaries used for lookups. Each holds the
+ * encoded words of all entries, in dictionary order for the ordered
+ * searches of word completion, and an open addressing hash table of
+ * entry numbers for exact matches. An index is built the first time a
+ * dictionary is searched. One in dynamic memory marks its pages in
+ * dict_page, so every write there bumps dict_writes, and it is rebuilt
+ * when that has moved since.
+ *
+ */
+
+#define DICT_INDEXES 4
+
+typedef struct {
+    zword dct;			/* dictionary address, 0 if unused */
+    zword entries;		/* address of the first entry */
+    zword entry_count;
+    zbyte entry_len;
+    bool sorted;
+    bool hashed;		/* FALSE if a "sorted" one isn't, really */
+    zword *words;		/* resolution words per entry */
+    zword *hash;		/* entry number + 1, 0 if empty */
+    zword hash_mask;
+    long end;			/* first byte after the entries */
+    bool dynamic;		/* in dynamic memory, check writes */
+    unsigned long writes;	/* dict_writes when it was built */
+} dict_index_t;
+
+static dict_index_t dict_indexes[DICT_INDEXES];
+static int dict_next = 0;
+
 /*
  * According to Matteo De Luigi <matteo.de.luigi@libero.it>,
  * 0xab and 0xbb were in each other's proper positions.
@@ -752,6 +785,231 @@ void z_print_unicode (void)
 }/* z_print_unicode */
 
 
+/*
+ * hash_words
+ *
+ * Hash an encoded word.
+ *
+ */
+static zword hash_words (const zword *words, int resolution)
+{
+    unsigned long h = 0;
+    int i;
+
+    for (i = 0; i < resolution; i++)
+	h = (h ^ words[i]) * 0x9e3779b1UL;
+
+    return (zword) ((h & 0xffffffffUL) >> 16);
+
+}/* hash_words */
+
+
+/*
+ * free_dict_index
+ *
+ * Release an index slot.
+ *
+ */
+static void free_dict_index (dict_index_t *index)
+{
+    free (index->words);
+    free (index->hash);
+
+    memset (index, 0, sizeof (dict_index_t));
+
+}/* free_dict_index */
+
+
+/*
+ * mark_dict_pages
+ *
+ * Set dict_page for the pages of all dictionaries in dynamic memory.
+ *
+ */
+static void mark_dict_pages (void)
+{
+    int i;
+    long page;
+
+    memset (dict_page, 0, sizeof (dict_page));
+
+    for (i = 0; i < DICT_INDEXES; i++)
+	if (dict_indexes[i].dynamic && dict_indexes[i].end > dict_indexes[i].dct)
+	    for (page = dict_indexes[i].dct >> UNDO_PAGE_SHIFT;
+		 page <= (dict_indexes[i].end - 1) >> UNDO_PAGE_SHIFT;
+		 page++)
+		dict_page[page] = 1;
+
+}/* mark_dict_pages */
+
+
+/*
+ * flush_dictionaries
+ *
+ * Forget all dictionary indexes. Called when a store has gone past the
+ * dynamic area and may have changed a dictionary.
+ *
+ */
+void flush_dictionaries (void)
+{
+    int i;
+
+    for (i = 0; i < DICT_INDEXES; i++)
+	free_dict_index (dict_indexes + i);
+
+    mark_dict_pages ();
+
+}/* flush_dictionaries */
+
+
+/*
+ * build_dict_index
+ *
+ * Read a dictionary into an index slot. Returns FALSE if it doesn't
+ * fit the story file or memory runs out.
+ *
+ */
+static bool build_dict_index (dict_index_t *index, zword dct)
+{
+    zword addr;
+    zword entry_count;
+    zbyte entry_len;
+    zbyte sep_count;
+    int resolution = (h_version <= V3) ? 2 : 3;
+    long end;
+    int size;
+    int n, i;
+
+    addr = dct;
+    LOW_BYTE (addr, sep_count)
+    addr += 1 + sep_count;
+    LOW_BYTE (addr, entry_len)
+    addr += 1;
+    LOW_WORD (addr, entry_count)
+    addr += 2;
+
+    index->dct = dct;
+    index->entries = addr;
+    index->entry_len = entry_len;
+    index->sorted = (short) entry_count >= 0;
+    if (!index->sorted)
+	entry_count = - (short) entry_count;
+    index->entry_count = entry_count;
+
+    end = (long) addr + (long) entry_count * entry_len;
+
+    if (entry_len < 2 * resolution || end > story_size || end > 0x10000L)
+	return FALSE;
+
+    for (size = 1; size < 2 * entry_count; size <<= 1)
+	;
+
+    index->words = malloc ((entry_count + 1) * resolution * sizeof (zword));
+    index->hash = calloc (size, sizeof (zword));
+    index->hash_mask = size - 1;
+
+    if (index->words == NULL || index->hash == NULL)
+	return FALSE;
+
+    index->end = end;
+    index->dynamic = dct < h_dynamic_size;
+    index->writes = dict_writes;
+
+    index->hashed = TRUE;
+
+    for (n = 0; n < entry_count; n++) {
+
+	zword *words = index->words + n * resolution;
+	zword h;
+
+	for (i = 0; i < resolution; i++) {
+	    LOW_WORD (addr, words[i])
+	    addr += 2;
+	}
+	addr += entry_len - 2 * resolution;
+
+	/* A binary search on an unsorted list can't be replaced */
+
+	if (index->sorted && n > 0) {
+
+	    for (i = 0; i < resolution; i++)
+		if (words[i - resolution] != words[i])
+		    break;
+	    if (i == resolution || words[i - resolution] > words[i])
+		index->hashed = FALSE;
+
+	}
+
+	/* Keep the first of equal words, the linear search finds it */
+
+	for (h = hash_words (words, resolution) & index->hash_mask;
+	     index->hash[h] != 0;
+	     h = (h + 1) & index->hash_mask)
+	    if (memcmp (index->words + (index->hash[h] - 1) * resolution,
+			words, resolution * sizeof (zword)) == 0)
+		break;
+
+	if (index->hash[h] == 0)
+	    index->hash[h] = n + 1;
+
+    }
+
+    return TRUE;
+
+}/* build_dict_index */
+
+
+/*
+ * get_dict_index
+ *
+ * Return the index of a dictionary, building it if needed, or NULL to
+ * search the dictionary in memory.
+ *
+ */
+static dict_index_t *get_dict_index (zword dct)
+{
+    dict_index_t *index;
+    int i;
+
+    for (i = 0; i < DICT_INDEXES; i++) {
+
+	index = dict_indexes + i;
+
+	if (index->dct != dct)
+	    continue;
+
+	if (index->words == NULL)	/* couldn't be built */
+	    return NULL;
+
+	if (!index->dynamic || index->writes == dict_writes)
+	    return index;
+
+	free_dict_index (index);
+	break;
+
+    }
+
+    if (i == DICT_INDEXES) {
+	i = dict_next;
+	dict_next = (dict_next + 1) % DICT_INDEXES;
+    }
+
+    index = dict_indexes + i;
+    free_dict_index (index);
+
+    if (!build_dict_index (index, dct)) {
+	free_dict_index (index);
+	index->dct = dct;		/* don't try again */
+	index = NULL;
+    }
+
+    mark_dict_pages ();
+
+    return index;
+
+}/* get_dict_index */
+
+
 /*
  * lookup_text
  *
@@ -762,11 +1020,14 @@ void z_print_unicode (void)
  * 0x05 - find the word which exactly matches the given one
  * 0x1f - find the last word which is <= the given one
  *
- * The return value is 0 if the search fails.
+ * The return value is 0 if the search fails. Exact matches come from
+ * the hash table of the dictionary's index, the other two searches
+ * run over the index's copy of the encoded words.
  *
  */
 static zword lookup_text (int padding, zword dct)
 {
+    dict_index_t *index;
     zword entry_addr;
     zword entry_count;
     zword entry;
@@ -781,6 +1042,29 @@ static zword lookup_text (int padding, zword dct)
 
     encode_text (padding);
 
+    index = get_dict_index (dct);
+
+    if (index != NULL && index->hashed && padding == 0x05) {
+
+	zword h = hash_words (encoded, resolution) & index->hash_mask;
+
+	while ((entry_number = index->hash[h]) != 0) {
+
+	    const zword *words = index->words + --entry_number * resolution;
+
+	    for (i = 0; i < resolution; i++)
+		if (encoded[i] != words[i])
+		    break;
+	    if (i == resolution)
+		return index->entries + entry_number * index->entry_len;
+
+	    h = (h + 1) & index->hash_mask;
+
+	}
+
+	return 0;
+    }
+
     LOW_BYTE (dct, sep_count)		/* skip word separators */
     dct += 1 + sep_count;
     LOW_BYTE (dct, entry_len)		/* get length of entries */
@@ -812,7 +1096,10 @@ static zword lookup_text (int padding, zword dct)
 	addr = entry_addr;
 
 	for (i = 0; i < resolution; i++) {
-	    LOW_WORD (addr, entry)
+	    if (index != NULL)
+		entry = index->words[entry_number * resolution + i];
+	    else
+		LOW_WORD (addr, entry)
 	    if (encoded[i] != entry)
 		goto continuing;
 	    addr += 2;
@@ -0,0 +1,270 @@
+/* dumb-batch.c
+ *
+ * Batch mode: run every story of a manifest in a process of its own,
+ * with stdin read from the run's input script, and report the wall
+ * time, the number of Z-machine instructions executed and a hash of
+ * the transcript of each run.
+ *
+ * The manifest has one run per line, "story input [hash]"; blank lines
+ * and lines starting with # are skipped. If a hash is given the run
+ * fails when the transcript doesn't match it.
+ *
+ * Needs fork(), so it isn't available under the TempleOS loader.
+ */
+
+#include "dumb_frotz.h"
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+typedef struct {
+    char *story;
+    char *input;
+    char *expect;		/* transcript hash, NULL if not given */
+    FILE *transcript;		/* until the run is reaped */
+    unsigned long hash;
+    pid_t pid;
+    int status;
+    double start;
+    double wall;
+} batch_run_t;
+
+static batch_run_t *runs = NULL;
+static int run_count = 0;
+
+/* Instruction counts, written by the children at exit */
+static unsigned long *counts = NULL;
+static int this_run = -1;
+
+static double batch_time(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void batch_exit(void)
+{
+    counts[this_run] = instruction_count;
+}
+
+static char *batch_strdup(const char *s)
+{
+    char *p = malloc(strlen(s) + 1);
+
+    if (p == NULL) {
+	fputs("batch: out of memory\n", stderr);
+	exit(1);
+    }
+    return strcpy(p, s);
+}
+
+static void read_manifest(const char *name)
+{
+    FILE *fp;
+    char line[FILENAME_MAX * 2 + 64];
+    int line_number = 0;
+    int size = 0;
+
+    if ((fp = fopen(name, "r")) == NULL) {
+	fprintf(stderr, "batch: can't open %s\n", name);
+	exit(1);
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+	char *story, *input, *expect;
+
+	line_number++;
+	story = strtok(line, " \t\r\n");
+	if (story == NULL || *story == '#')
+	    continue;
+	input = strtok(NULL, " \t\r\n");
+	expect = strtok(NULL, " \t\r\n");
+	if (input == NULL) {
+	    fprintf(stderr, "batch: %s:%d: no input script\n", name,
+		    line_number);
+	    exit(1);
+	}
+
+	if (run_count == size) {
+	    size = size ? size * 2 : 64;
+	    runs = realloc(runs, size * sizeof(batch_run_t));
+	    if (runs == NULL) {
+		fputs("batch: out of memory\n", stderr);
+		exit(1);
+	    }
+	}
+	memset(&runs[run_count], 0, sizeof(batch_run_t));
+	runs[run_count].story = batch_strdup(story);
+	runs[run_count].input = batch_strdup(input);
+	if (expect != NULL)
+	    runs[run_count].expect = batch_strdup(expect);
+	run_count++;
+    }
+
+    fclose(fp);
+}
+
+/* FNV-1a of the transcript */
+static unsigned long hash_transcript(FILE *fp)
+{
+    unsigned long h = 2166136261UL;
+    int c;
+
+    rewind(fp);
+    while ((c = getc(fp)) != EOF)
+	h = ((h ^ (unsigned char) c) * 16777619UL) & 0xffffffffUL;
+
+    return h;
+}
+
+/* Fork a run, returns TRUE in the child */
+static bool start_run(int i)
+{
+    batch_run_t *r = &runs[i];
+
+    if ((r->transcript = tmpfile()) == NULL) {
+	fputs("batch: can't create a transcript file\n", stderr);
+	exit(1);
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+
+    r->start = batch_time();
+    r->pid = fork();
+
+    if (r->pid < 0) {
+	fputs("batch: fork failed\n", stderr);
+	exit(1);
+    }
+
+    if (r->pid == 0) {
+	if (freopen(r->input, "r", stdin) == NULL) {
+	    fprintf(stderr, "batch: can't open %s\n", r->input);
+	    _exit(127);
+	}
+	dup2(fileno(r->transcript), 1);
+	dup2(fileno(r->transcript), 2);
+	this_run = i;
+	count_instructions = TRUE;
+	atexit(batch_exit);
+	return TRUE;
+    }
+
+    return FALSE;
+}
+
+static void report(double wall)
+{
+    unsigned long total = 0;
+    int failed = 0;
+    int i;
+
+    printf("%-24s %-24s %-7s %9s %12s %11s %s\n", "story", "input",
+	   "result", "wall ms", "instructions", "instr/s", "hash");
+
+    for (i = 0; i < run_count; i++) {
+	batch_run_t *r = &runs[i];
+	char result[16];
+	char hex[16];
+
+	sprintf(hex, "%08lx", r->hash);
+
+	if (WIFSIGNALED(r->status))
+	    sprintf(result, "sig %d", WTERMSIG(r->status));
+	else if (WEXITSTATUS(r->status) != 0)
+	    sprintf(result, "exit %d", WEXITSTATUS(r->status));
+	else if (r->expect != NULL && strcmp(r->expect, hex) != 0)
+	    strcpy(result, "differs");
+	else
+	    strcpy(result, "ok");
+
+	if (strcmp(result, "ok") != 0)
+	    failed++;
+	total += counts[i];
+
+	printf("%-24s %-24s %-7s %9.1f %12lu %11.0f %s\n", r->story,
+	       r->input, result, r->wall * 1000, counts[i],
+	       r->wall > 0 ? counts[i] / r->wall : 0.0, hex);
+    }
+
+    printf("%d runs, %d failed, %.1f ms, %lu instructions, %.0f instr/s\n",
+	   run_count, failed, wall * 1000, total,
+	   wall > 0 ? total / wall : 0.0);
+
+    exit(failed ? 1 : 0);
+}
+
+/*
+ * Returns the story file in the child processes, with stdin and stdout
+ * redirected, the batch itself exits when all runs are reported.
+ */
+char *dumb_run_batch(const char *manifest, int jobs)
+{
+    double start = batch_time();
+    int next = 0;
+    int running = 0;
+
+#ifdef __UCLIBC__
+    /* The TempleOS build, whose loader has no fork() */
+    fputs("batch: -B needs fork(), which the TempleOS loader doesn't have\n",
+	  stderr);
+    exit(1);
+#endif
+
+    read_manifest(manifest);
+
+    if (jobs <= 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+	jobs = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (jobs <= 0)
+	    jobs = 1;
+    }
+
+    if (run_count > 0) {
+	counts = mmap(NULL, run_count * sizeof(unsigned long),
+		      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+		      -1, 0);
+	if (counts == MAP_FAILED) {
+	    fputs("batch: can't map the shared counters\n", stderr);
+	    exit(1);
+	}
+	memset(counts, 0, run_count * sizeof(unsigned long));
+    }
+
+    while (next < run_count || running > 0) {
+	int status;
+	pid_t pid;
+	int i;
+
+	for (; running < jobs && next < run_count; next++, running++)
+	    if (start_run(next))
+		return runs[next].story;
+
+	if ((pid = wait(&status)) < 0)
+	    break;
+
+	for (i = 0; i < run_count; i++)
+	    if (runs[i].pid == pid) {
+		runs[i].wall = batch_time() - runs[i].start;
+		runs[i].status = status;
+		runs[i].hash = hash_transcript(runs[i].transcript);
+		fclose(runs[i].transcript);
+		runs[i].transcript = NULL;
+		running--;
+		break;
+	    }
+    }
+
+    report(batch_time() - start);
+    return NULL;
+}
@@ -40,3 +40,6 @@ void dumb_set_picture_cell(int row, int col, char c);
 
 /* dumb-pic.c */
 void dumb_init_pictures(char *graphics_filename);
+
+/* dumb-batch.c */
+char *dumb_run_batch(const char *manifest, int jobs);
@@ -14,8 +14,10 @@ An interpreter for all Infocom and other Z-Machine games.\n\
 Complies with standard 1.0 of Graham Nelson's specification.\n\
 \n\
 Syntax: dfrotz [options] story-file\n\
+        dfrotz [options] -B manifest\n\
   -a   watch attribute setting \t  R xxx  do runtime setting \\xxx\n\
   -A   watch attribute testing \t    before starting (can be used repeatedly)\n\
+  -B f run a batch manifest    \t -j # parallel runs for -B\n\
   -h # screen height           \t -s # random number seed value\n\
   -i   ignore fatal errors     \t -S # transcript width\n\
   -I # interpreter number      \t -t   set Tandy bit\n\
@@ -68,6 +70,8 @@ static int user_random_seed = -1;
 static int user_tandy_bit = 0;
 static char *graphics_filename = NULL;
 static bool plain_ascii = FALSE;
+static char *batch_manifest = NULL;
+static int batch_jobs = 0;
 
 void os_process_arguments(int argc, char *argv[])
 {
@@ -76,13 +80,15 @@ void os_process_arguments(int argc, char *argv[])
     do_more_prompts = TRUE;
     /* Parse the options */
     do {
-	c = zgetopt(argc, argv, "aAh:iI:moOpPs:R:S:tu:w:xZ:");
+	c = zgetopt(argc, argv, "aAB:h:iI:j:moOpPs:R:S:tu:w:xZ:");
 	switch(c) {
 	  case 'a': f_setup.attribute_assignment = 1; break;
 	  case 'A': f_setup.attribute_testing = 1; break;
+	case 'B': batch_manifest = zoptarg; break;
 	case 'h': user_screen_height = atoi(zoptarg); break;
 	  case 'i': f_setup.ignore_errors = 1; break;
 	  case 'I': f_setup.interpreter_number = atoi(zoptarg); break;
+	case 'j': batch_jobs = atoi(zoptarg); break;
 	  case 'm': do_more_prompts = FALSE;
 	  case 'o': f_setup.object_movement = 1; break;
 	  case 'O': f_setup.object_locating = 1; break;
@@ -103,6 +109,14 @@ void os_process_arguments(int argc, char *argv[])
 	}
     } while (c != EOF);
 
+    if (batch_manifest != NULL && argc == zoptind) {
+	f_setup.story_file = dumb_run_batch(batch_manifest, batch_jobs);
+	f_setup.save_name = malloc(FILENAME_MAX);
+	f_setup.aux_name = malloc(FILENAME_MAX);
+	strcpy(f_setup.aux_name, "story.aux");
+	return;
+    }
+
     if (((argc - zoptind) != 1) && ((argc - zoptind) != 2)) {
 	printf("FROTZ V%s\tdumb interface.\n", VERSION);
 	puts(INFORMATION);
@@ -111,6 +125,9 @@ void os_process_arguments(int argc, char *argv[])
 	    "\t     %d = report all errors     %d = exit after any error\n\n",
 	    ERR_DEFAULT_REPORT_MODE, ERR_REPORT_NEVER,
 	    ERR_REPORT_ONCE, ERR_REPORT_ALWAYS, ERR_REPORT_FATAL);
+	printf("A batch manifest lists one run per line, \"story input [hash]\".\n"
+	    "Every run is a process of its own reading its input script, the\n"
+	    "wall time, instructions per second and transcript hash are reported.\n\n");
 	printf("While running, enter \"\\help\" to list the runtime escape sequences\n\n");
 	exit(1);
     }
@@ -125,6 +142,8 @@ void os_process_arguments(int argc, char *argv[])
 	graphics_filename = argv[zoptind++];
 
     f_setup.save_name = malloc(FILENAME_MAX);
+    f_setup.aux_name = malloc(FILENAME_MAX);
+    strcpy(f_setup.aux_name, "story.aux");
 }
 
 void os_init_screen(void)
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+#
+# Builds dictwrite.z5, a version 5 story that tokenises with a dictionary
+# of its own in dynamic memory, rewrites the dictionary's last entry and
+# tokenises again. The dictionary header sits at the end of one 64-byte
+# page and its entries on the next, so the stores only land on the
+# second page. The text and parse buffers are on a page of their own.
+# It prints the entry address found for "bar", then for
+# "bar" and "baz" after "bar" has been rewritten to "baz":
+#
+#   966
+#   0
+#   966
+#
+import sys
+
+TEXT = 0x360        # text buffer, "bar"
+PARSE = 0x378       # parse buffer, one word, on the page of the text
+DICT = 0x3bb        # user dictionary, entries from 0x3c0
+STATIC = 0x3d0      # start of static memory, the standard dictionary
+CODE = 0x400
+
+
+def encode(word):
+    z = [ord(c) - ord('a') + 6 for c in word] + [5] * (9 - len(word))
+    w = [(z[i] << 10) | (z[i + 1] << 5) | z[i + 2] for i in range(0, 9, 3)]
+    w[2] |= 0x8000
+    return w
+
+
+def word(v):
+    return [(v >> 8) & 0xff, v & 0xff]
+
+
+def tokenise_and_print():
+    return ([0xfb, 0x03] + word(TEXT) + word(PARSE) + word(DICT) +
+            [0xcf, 0x1f] + word(PARSE) + [1, 0x00] +  # loadw parse 1 -> sp
+            [0xe6, 0xbf, 0x00] +                      # print_num sp
+            [0xbb])                                   # new_line
+
+
+story = bytearray(0x400)
+story[0x00] = 5
+story[0x04:0x06] = word(CODE)
+story[0x06:0x08] = word(CODE)
+story[0x08:0x0a] = word(STATIC)
+story[0x0a:0x0c] = word(0x100)
+story[0x0c:0x0e] = word(0x180)
+story[0x0e:0x10] = word(STATIC)
+story[0x18:0x1a] = word(0x40)
+
+story[TEXT:TEXT + 5] = bytes([20, 3]) + b"bar"
+story[PARSE] = 1
+
+entries = encode("foo") + encode("bar")
+# one separator, as tokenise_line reads at least one; unsorted
+story[DICT:DICT + 5] = bytes([1, ord(','), 6] + word(-2 & 0xffff))
+for i, w in enumerate(entries):
+    story[DICT + 5 + 2 * i:DICT + 7 + 2 * i] = word(w)
+story[STATIC:STATIC + 5] = bytes([1, ord(','), 6, 0, 0])
+
+code = tokenise_and_print()
+for i, w in enumerate(encode("baz")):         # storew DICT+11 i w
+    code += [0xe1, 0x13] + word(DICT + 11) + [i] + word(w)
+code += tokenise_and_print()
+code += [0xe2, 0x17] + word(TEXT + 4) + [0, ord('z')]  # storeb text 'z'
+code += tokenise_and_print()
+code += [0xba]                                # quit
+
+story += bytes(code)
+story += bytes(-len(story) % 4)
+story[0x1a:0x1c] = word(len(story) // 4)
+
+with open(sys.argv[1] if len(sys.argv) > 1 else "dictwrite.z5", "wb") as f:
+    f.write(story)
@@ -36,11 +36,13 @@ static const char rcsid[] = "$Id: d_main.c,v 1.8 1997/02/03 22:45:09 b1 Exp $";
 #ifdef HEADLESS  
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <sys/time.h>
+#include <time.h>
 #endif
 
 #include "doomdef.h"
@@ -355,6 +357,173 @@ void D_Display (void)
 extern  boolean         demorecording;
 
 
+//
+//  BENCHMARK
+//
+// Started with -bench, -demos or -crctics on the command line.
+// Each tic is timed in two parts, the game logic and the refresh,
+// and the times are summed up when the last demo has finished.
+// Every crctics tics a CRC of the frame buffer is printed, so that
+// the output of one build can be checked against another: unlike
+// the times, the CRCs don't depend on the clock.
+//
+static boolean		benchmark;
+static int		crctics = 35;
+static char**		benchdemos;	// -demos list, or NULL for the usual ones
+static int		numbenchdemos;
+
+static unsigned*	logictimes;
+static unsigned*	rendertimes;
+static int		numtimes;
+static int		maxtimes;
+static unsigned		crctable[256];
+
+
+//
+// D_Microseconds
+// Monotonic, both loaders keep the time of day fixed.
+//
+static unsigned D_Microseconds (void)
+{
+    struct timespec	ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+
+//
+// D_FrameCRC
+// CRC-32 of the frame just drawn.
+//
+static unsigned D_FrameCRC (void)
+{
+    unsigned	crc;
+    byte*	src;
+    int		i;
+
+    if (!crctable[1])
+    {
+	for (i = 0; i < 256; i++)
+	{
+	    int	j;
+
+	    crc = i;
+	    for (j = 0; j < 8; j++)
+		crc = (crc >> 1) ^ (crc & 1 ? 0xedb88320 : 0);
+	    crctable[i] = crc;
+	}
+    }
+
+    crc = 0xffffffff;
+    src = screens[0];
+    for (i = 0; i < SCREENWIDTH*SCREENHEIGHT; i++)
+	crc = crctable[(crc ^ src[i]) & 0xff] ^ (crc >> 8);
+    return crc ^ 0xffffffff;
+}
+
+
+//
+// D_BenchmarkTic
+// Called at the end of every tic in benchmark mode, with
+// the microseconds spent in the game logic and the refresh.
+//
+static void D_BenchmarkTic (unsigned logic, unsigned render)
+{
+    if (numtimes == maxtimes)
+    {
+	maxtimes = maxtimes ? maxtimes*2 : 4096;
+	logictimes = realloc (logictimes, maxtimes*sizeof(*logictimes));
+	rendertimes = realloc (rendertimes, maxtimes*sizeof(*rendertimes));
+	if (!logictimes || !rendertimes)
+	    I_Error ("D_BenchmarkTic: no memory for %i tics", maxtimes);
+    }
+    logictimes[numtimes] = logic;
+    rendertimes[numtimes] = render;
+    numtimes++;
+
+    if (crctics > 0 && gametic % crctics == 0)
+	printf ("tic %i crc %08x\n", gametic, D_FrameCRC ());
+}
+
+
+static int D_CompareTimes (const void* a, const void* b)
+{
+    unsigned	x = *(const unsigned *)a;
+    unsigned	y = *(const unsigned *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+
+static void D_PrintTimes (char* what, unsigned* times)
+{
+    double	total;
+    int		i;
+
+    qsort (times, numtimes, sizeof(*times), D_CompareTimes);
+    total = 0;
+    for (i = 0; i < numtimes; i++)
+	total += times[i];
+
+    printf ("%-7s p50 %6u p90 %6u p99 %6u max %6u mean %8.1f us\n",
+	    what,
+	    times[numtimes*50/100],
+	    times[numtimes*90/100],
+	    times[numtimes*99/100],
+	    times[numtimes-1],
+	    total / numtimes);
+}
+
+
+//
+// D_BenchmarkReport
+// Sums up the tic times, once all the demos have been played.
+//
+static void D_BenchmarkReport (void)
+{
+    if (!benchmark || !numtimes)
+	return;
+
+    printf ("benchmark: %i tics\n", numtimes);
+    D_PrintTimes ("logic", logictimes);
+    D_PrintTimes ("render", rendertimes);
+}
+
+
+//
+// D_BenchmarkArgs
+// Looks for the benchmark options in the real command line;
+// the rest of it is ignored in headless mode.
+//
+static void D_BenchmarkArgs (int argc, char** argv)
+{
+    int		i;
+
+    for (i = 1; i < argc; i++)
+    {
+	if (!strcasecmp (argv[i], "-bench"))
+	    benchmark = true;
+	else if (!strcasecmp (argv[i], "-crctics") && i < argc-1)
+	{
+	    benchmark = true;
+	    crctics = atoi (argv[++i]);
+	}
+	else if (!strcasecmp (argv[i], "-demos"))
+	{
+	    // the parms after -demos are lump names,
+	    // until end of parms or another - preceded parm
+	    benchmark = true;
+	    benchdemos = argv + i + 1;
+	    while (i+1 < argc && argv[i+1][0] != '-')
+		i++;
+	    numbenchdemos = argv + i + 1 - benchdemos;
+	}
+    }
+}
+
+
+
 
 
 //
@@ -416,6 +585,19 @@ void D_AdvanceDemo (void)
 #endif
     demosequence++;
     printf ("demo sequence %d\n", demosequence);
+
+    // a -demos list is played straight through, without pages
+    if (numbenchdemos)
+    {
+	if (demosequence < numbenchdemos)
+	{
+	    G_DeferedPlayDemo (benchdemos[demosequence]);
+	    return;
+	}
+	printf ("end of demos\n");
+	D_BenchmarkReport ();
+	exit (0);
+    }
     
     switch (demosequence)
     {
@@ -472,6 +654,7 @@ void D_AdvanceDemo (void)
         break;
       default:
         printf ("end of demos\n");
+        D_BenchmarkReport ();
         exit (0);
     }
 }
@@ -784,6 +967,7 @@ int main(int argc, char ** argv)
     headless_count = 0;
 #pragma RVS add_statement ("RVS_Init()");
     gettimeofday (&start, NULL);
+    D_BenchmarkArgs (argc, argv);
     return root ();
 }
 
@@ -1186,6 +1370,12 @@ int root (void)
 
 
         while (1) {
+            unsigned ticstart = 0, ticlogic = 0;
+
+            // the clock is only read when the tics are timed
+            if (benchmark)
+                ticstart = D_Microseconds ();
+
             // frame syncronous IO operations
             I_StartFrame ();                
             
@@ -1206,6 +1396,8 @@ int root (void)
             {
                 TryRunTics (); // will run at least one tic
             }
+            if (benchmark)
+                ticlogic = D_Microseconds ();
                 
             S_UpdateSounds (players[consoleplayer].mo);// move positional sounds
 
@@ -1221,6 +1413,8 @@ int root (void)
             // Update sound output.
             I_SubmitSound();
 #endif
+            if (benchmark)
+                D_BenchmarkTic (ticlogic - ticstart, D_Microseconds () - ticlogic);
         }
     }
 
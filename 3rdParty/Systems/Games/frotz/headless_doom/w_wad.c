@@ -65,6 +65,13 @@ int			numlumps;
 
 void**			lumpcache;
 
+// Hash chains over the lump names, so that W_CheckNumForName
+// does not have to scan the whole directory. Each chain lists
+// later lumps first, so a later file still overrides earlier ones.
+static int*		lumphash;
+static int*		lumpnext;
+static unsigned		lumphashmask;
+
 
 #define strcmpi	strcasecmp
 
@@ -119,6 +126,59 @@ ExtractFileBase
 
 
 
+//
+// W_LumpNameHash
+// The name is the two ints W_CheckNumForName compares.
+//
+static unsigned W_LumpNameHash (int v1, int v2)
+{
+    unsigned	h;
+
+    h = (unsigned) v1 * 0x9e3779b1u;
+    h ^= (unsigned) v2 * 0x85ebca6bu;
+    return h ^ (h >> 16);
+}
+
+
+//
+// W_HashLumps
+// (Re)builds the hash chains for all numlumps lumps.
+//
+static void W_HashLumps (void)
+{
+    int		i;
+    unsigned	size;
+    unsigned	h;
+    lumpinfo_t*	lump_p;
+
+    free (lumphash);
+    free (lumpnext);
+
+    for (size = 1; size < numlumps; size <<= 1)
+	;
+
+    lumphash = malloc (size*sizeof(*lumphash));
+    lumpnext = malloc (numlumps*sizeof(*lumpnext));
+
+    if (!lumphash || !lumpnext)
+	I_Error ("Couldn't allocate lump hash table");
+
+    lumphashmask = size - 1;
+    memset (lumphash, -1, size*sizeof(*lumphash));
+
+    // insert in order, so each chain starts with the latest lump
+    for (i=0, lump_p=lumpinfo ; i<numlumps ; i++, lump_p++)
+    {
+	h = W_LumpNameHash (*(int *)lump_p->name,
+			    *(int *)&lump_p->name[4]) & lumphashmask;
+	lumpnext[i] = lumphash[h];
+	lumphash[h] = i;
+    }
+}
+
+
+
+
 //
 // LUMP BASED ROUTINES.
 //
@@ -280,6 +340,8 @@ void W_Reload (void)
 	
     close (handle);
     free (free_me);
+
+    W_HashLumps ();
 }
 
 
@@ -321,6 +383,8 @@ void W_InitMultipleFiles (char** filenames)
 	I_Error ("Couldn't allocate lumpcache");
 
     memset (lumpcache,0, size);
+
+    W_HashLumps ();
 }
 
 
@@ -366,6 +430,7 @@ int W_CheckNumForName (char* name)
     
     int		v1;
     int		v2;
+    int		i;
     lumpinfo_t*	lump_p;
 
     // make the name into two integers for easy compares
@@ -381,16 +446,19 @@ int W_CheckNumForName (char* name)
     v2 = name8.x[1];
 
 
-    // scan backwards so patch lump files take precedence
-    lump_p = lumpinfo + numlumps;
+    // the chain has later lumps first, so patch lump files
+    // take precedence
+    i = lumphash[W_LumpNameHash (v1, v2) & lumphashmask];
 
-    while (lump_p-- != lumpinfo)
+    while (i != -1)
     {
+        lump_p = lumpinfo + i;
         if ( *(int *)lump_p->name == v1
              && *(int *)&lump_p->name[4] == v2)
         {
-            return lump_p - lumpinfo;
+            return i;
         }
+        i = lumpnext[i];
     }
 
     // TFB. Not found.
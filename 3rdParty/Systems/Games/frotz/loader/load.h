@@ -3,12 +3,12 @@
 
 #include <stdint.h>
 
-#define MAX_HEAP_SIZE 0x1000000     /* 16M - heap size */
+#define MAX_HEAP_SIZE 0x100000      /* 1M - brk area, then mmap */
 #define MAX_SIZE      0x1000000     /* 16M - program size */
 #define MAX_STACK_SIZE 0x20000      /* 128k - stack size */
 
 int64_t syscall_handler (int64_t syscall_number,
-        int64_t p0, int64_t p1, int64_t p2);
+        int64_t p0, int64_t p1, int64_t p2, int64_t p3, int64_t p4);
 void init_syscall (uint64_t _break_start, uint64_t _break_end);
 
 size_t init_load (const char * source_fname);
@@ -56,11 +56,22 @@ fini_end:
 
 .text
 _tos_syscall:
+    # r8 and r9 are syscall inputs the caller expects back unchanged,
+    # the 24 bytes pushed keep the handler's stack alignment as it was
+    push    %r8
+    push    %r9
+    sub     $8, %rsp
+    mov     %r8, %r9        # syscall arg 5 ->  Linux arg 6
+    mov     %r10, %r8       # syscall arg 4 ->  Linux arg 5
     mov     %rdx, %rcx      # syscall arg 3 ->  Linux arg 4
     mov     %rsi, %rdx      # syscall arg 2 ->  Linux arg 3
     mov     %rdi, %rsi      # syscall arg 1 ->  Linux arg 2
     mov     %rax, %rdi      # syscall number -> Linux arg 1
-    jmpq    *syscall_address(%rip)
+    callq   *syscall_address(%rip)
+    add     $8, %rsp
+    pop     %r9
+    pop     %r8
+    retq
 
 _tos_hlt:
     mov     $99999, %rax
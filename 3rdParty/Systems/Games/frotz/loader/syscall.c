@@ -9,6 +9,18 @@
 #include "load.h"
 
 #define MAX_FD_HANDLES 0x10
+#define MAX_MAPS       0x100
+#define ALIGN_SIZE     0x1000
+
+#define ENOMEM           12
+#define EFAULT           14
+#define ENODEV           19
+#define EINVAL           22
+
+#define MAP_PRIVATE      0x02
+#define MAP_ANONYMOUS    0x20
+
+#define MREMAP_MAYMOVE   1
 
 #define O_WRONLY         01
 #define O_RDWR           02
@@ -35,6 +47,16 @@ struct __kernel_termios
 static uint64_t break_start, break_end;
 static FILE * fd_handle[MAX_FD_HANDLES];
 
+struct map
+{
+    void *   true_base;     /* as returned by malloc, NULL if unused */
+    uint64_t start;
+    uint64_t size;
+    uint64_t capacity;
+};
+
+static struct map map_table[MAX_MAPS];
+
 void init_syscall (uint64_t _break_start, uint64_t _break_end)
 {
     fd_handle[STDIN_FILENO] = stdin;
@@ -61,6 +83,120 @@ static int64_t do_ioctl (int64_t p0, int64_t p1, int64_t p2)
     }
 }
 
+static struct map * find_map (uint64_t addr)
+{
+    unsigned i;
+
+    for (i = 0; i < MAX_MAPS; i++) {
+        if ((map_table[i].true_base != NULL)
+        && (addr >= map_table[i].start)
+        && (addr < (map_table[i].start + map_table[i].size))) {
+            return &map_table[i];
+        }
+    }
+    return NULL;
+}
+
+static struct map * alloc_map (uint64_t size)
+{
+    unsigned i;
+    void * true_base;
+
+    for (i = 0; i < MAX_MAPS; i++) {
+        if (map_table[i].true_base == NULL) {
+            true_base = calloc (1, size + ALIGN_SIZE);
+            if (true_base == NULL) {
+                return NULL;
+            }
+            map_table[i].true_base = true_base;
+            map_table[i].start = ((uint64_t) true_base + ALIGN_SIZE - 1)
+                                    / ALIGN_SIZE * ALIGN_SIZE;
+            map_table[i].size = size;
+            map_table[i].capacity = size;
+            return &map_table[i];
+        }
+    }
+    return NULL;
+}
+
+static int64_t do_mmap (uint64_t size, int64_t flags)
+{
+    /* private anonymous memory only, as used by malloc: the address
+     * hint is ignored, files, shared and fixed maps are refused */
+    struct map * m;
+
+    if (!(flags & MAP_ANONYMOUS)) {
+        return -ENODEV;
+    }
+    if (flags != (MAP_PRIVATE | MAP_ANONYMOUS)) {
+        return -EINVAL;
+    }
+    size = (size + ALIGN_SIZE - 1) / ALIGN_SIZE * ALIGN_SIZE;
+    if (size == 0) {
+        return -EINVAL;
+    }
+    m = alloc_map (size);
+    if (m == NULL) {
+        return -ENOMEM;
+    }
+    return m->start;
+}
+
+static int64_t do_munmap (uint64_t addr, uint64_t size)
+{
+    struct map * m = find_map (addr);
+
+    if (m == NULL) {
+        return 0;
+    }
+    if ((addr + size) >= (m->start + m->size)) {
+        if (addr == m->start) {
+            free (m->true_base);
+            m->true_base = NULL;
+        } else {
+            /* tail unmapped: the memory is released with the rest */
+            m->size = addr - m->start;
+        }
+    }
+    /* unmapping the head or the middle of a map does nothing, the
+     * pages stay until the whole map goes; malloc never does that */
+    return 0;
+}
+
+static int64_t do_mremap (uint64_t addr, uint64_t size, int64_t flags)
+{
+    /* a map grows in place up to its capacity, beyond that it moves,
+     * which needs MREMAP_MAYMOVE; MREMAP_FIXED is refused */
+    struct map * m = find_map (addr);
+    struct map * n;
+
+    if (flags & ~MREMAP_MAYMOVE) {
+        return -EINVAL;
+    }
+    size = (size + ALIGN_SIZE - 1) / ALIGN_SIZE * ALIGN_SIZE;
+    if ((m == NULL) || (m->start != addr) || (size == 0)) {
+        return -EFAULT;
+    }
+    if (size <= m->capacity) {
+        if (size > m->size) {
+            memset ((void *) (m->start + m->size), 0, size - m->size);
+        }
+        m->size = size;
+        return addr;
+    }
+    if (!(flags & MREMAP_MAYMOVE)) {
+        return -ENOMEM;
+    }
+    n = alloc_map (size);
+    if (n == NULL) {
+        return -ENOMEM;
+    }
+    memcpy ((void *) n->start, (void *) m->start, m->size);
+    free (m->true_base);
+    m->true_base = NULL;
+    return n->start;
+}
+
 static int64_t do_open (int64_t p0, int64_t p1)
 {
     unsigned i;
@@ -94,7 +230,7 @@ static int64_t do_open (int64_t p0, int64_t p1)
 }
 
 int64_t syscall_handler (int64_t syscall_number,
-        int64_t p0, int64_t p1, int64_t p2)
+        int64_t p0, int64_t p1, int64_t p2, int64_t p3, int64_t p4)
 {
     int64_t rc;
 
@@ -153,6 +289,12 @@ int64_t syscall_handler (int64_t syscall_number,
                     break;
             }
             return rc;
+        case 9:
+            return do_mmap (p1, p3);
+        case 11:
+            return do_munmap (p0, p1);
+        case 25:
+            return do_mremap (p0, p2, p3);
         case 60:
             exit (p0);
             return 1;
@@ -179,9 +321,16 @@ int64_t syscall_handler (int64_t syscall_number,
                 memset ((void *) p1, 0, 8);
             }
             return 0;
+        case 228:
+            /* clock_gettime: the host clock, unlike the fixed time above */
+            if (clock_gettime ((clockid_t) p0, (struct timespec *) p1) != 0) {
+                return -EINVAL;
+            }
+            return 0;
         default:
-            printf ("Unsupported system call %u p0 %p p1 %p p2 %p\n",
-                    (unsigned) syscall_number, (void *) p0, (void *) p1, (void *) p2);
+            printf ("Unsupported system call %u p0 %p p1 %p p2 %p p3 %p p4 %p\n",
+                    (unsigned) syscall_number, (void *) p0, (void *) p1, (void *) p2,
+                    (void *) p3, (void *) p4);
             exit (1);
             return 0;
     }
@@ -24,6 +24,8 @@ syscall_shim:
     mov     %r14,0x70(%rsp)
     mov     %r15,0x78(%rsp)
 
+    mov     %r8, 0x20(%rsp) # Linux arg 5 -> Win arg 5
+    mov     %r9, 0x28(%rsp) # Linux arg 6 -> Win arg 6
     mov     %rdx, %r8       # Linux arg 3 -> Win arg 3
     mov     %rcx, %r9       # Linux arg 4 -> Win arg 4
     mov     %rdi, %rcx      # Linux arg 1 -> Win arg 1
@@ -0,0 +1,125 @@
+# Are the XMM registers usable by a program under the loader?
+# Under TempleOS, which leaves CR4.OSFXSR clear, the first SSE
+# instruction faults, so XMMTest.CPP only runs this when it is set.
+# Otherwise every XMM register gets a pattern which must survive
+# system calls.
+
+count = 1000000
+
+.text
+.global main
+.global puts
+.global exit
+.global time
+main:
+    lea     start_message(%rip), %rdi
+    call    puts
+
+    mov     $count, %rbx
+
+    lea     patterns(%rip), %rax
+    movdqu  0x000(%rax), %xmm0
+    movdqu  0x010(%rax), %xmm1
+    movdqu  0x020(%rax), %xmm2
+    movdqu  0x030(%rax), %xmm3
+    movdqu  0x040(%rax), %xmm4
+    movdqu  0x050(%rax), %xmm5
+    movdqu  0x060(%rax), %xmm6
+    movdqu  0x070(%rax), %xmm7
+    movdqu  0x080(%rax), %xmm8
+    movdqu  0x090(%rax), %xmm9
+    movdqu  0x0a0(%rax), %xmm10
+    movdqu  0x0b0(%rax), %xmm11
+    movdqu  0x0c0(%rax), %xmm12
+    movdqu  0x0d0(%rax), %xmm13
+    movdqu  0x0e0(%rax), %xmm14
+    movdqu  0x0f0(%rax), %xmm15
+
+check_loop:
+    mov     $0, %rdi
+    call    time
+
+    # store them all, then compare with the patterns
+    lea     saved(%rip), %rax
+    movdqu  %xmm0, 0x000(%rax)
+    movdqu  %xmm1, 0x010(%rax)
+    movdqu  %xmm2, 0x020(%rax)
+    movdqu  %xmm3, 0x030(%rax)
+    movdqu  %xmm4, 0x040(%rax)
+    movdqu  %xmm5, 0x050(%rax)
+    movdqu  %xmm6, 0x060(%rax)
+    movdqu  %xmm7, 0x070(%rax)
+    movdqu  %xmm8, 0x080(%rax)
+    movdqu  %xmm9, 0x090(%rax)
+    movdqu  %xmm10, 0x0a0(%rax)
+    movdqu  %xmm11, 0x0b0(%rax)
+    movdqu  %xmm12, 0x0c0(%rax)
+    movdqu  %xmm13, 0x0d0(%rax)
+    movdqu  %xmm14, 0x0e0(%rax)
+    movdqu  %xmm15, 0x0f0(%rax)
+
+    lea     patterns(%rip), %rsi
+    mov     $0x20, %rcx
+compare:
+    mov     -8(%rsi,%rcx,8), %rdx
+    cmp     -8(%rax,%rcx,8), %rdx
+    jnz     failure_xmm
+    dec     %rcx
+    jnz     compare
+
+    dec     %rbx
+    jnz     check_loop
+
+stop_now:
+    lea     ok_message(%rip), %rdi
+    call    puts
+    mov     $0, %rdi
+    call    exit
+
+.text
+failure_xmm:
+    # %rcx counts 64 bit halves from 1, the register is (%rcx - 1) / 2
+    lea     -1(%rcx), %rax
+    shr     $1, %rax
+    mov     $0x2030, %edx       # "0 "
+    cmp     $10, %rax
+    jb      one_digit
+    sub     $10, %rax
+    mov     $0x3031, %edx       # "10"
+    shl     $8, %rax
+one_digit:
+    add     %rax, %rdx
+    lea     failure_xmm_text(%rip), %rdi
+    mov     %dx, 12(%rdi)
+    call    puts
+    jmp     stop_now
+.data
+failure_xmm_text:
+    .ascii "failure xmm  \n\0"
+
+.data
+.balign 16
+patterns:
+    .quad   0x0123456789abcdef, 0xfedcba9876543210
+    .quad   0x1111111111111111, 0xeeeeeeeeeeeeeeee
+    .quad   0x2222222222222222, 0xdddddddddddddddd
+    .quad   0x3333333333333333, 0xcccccccccccccccc
+    .quad   0x4444444444444444, 0xbbbbbbbbbbbbbbbb
+    .quad   0x5555555555555555, 0xaaaaaaaaaaaaaaaa
+    .quad   0x6666666666666666, 0x9999999999999999
+    .quad   0x7777777777777777, 0x8888888888888888
+    .quad   0x8888888888888888, 0x7777777777777777
+    .quad   0x9999999999999999, 0x6666666666666666
+    .quad   0xaaaaaaaaaaaaaaaa, 0x5555555555555555
+    .quad   0xbbbbbbbbbbbbbbbb, 0x4444444444444444
+    .quad   0xcccccccccccccccc, 0x3333333333333333
+    .quad   0xdddddddddddddddd, 0x2222222222222222
+    .quad   0xeeeeeeeeeeeeeeee, 0x1111111111111111
+    .quad   0xfedcba9876543210, 0x0123456789abcdef
+saved:
+    .fill   0x100, 1, 0
+
+start_message:
+    .ascii  "XMM registers across system calls\n\n\0"
+ok_message:
+    .ascii  "exit\n\n\0"
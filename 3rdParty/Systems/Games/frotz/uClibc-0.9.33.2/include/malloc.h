@@ -128,7 +128,7 @@ extern __malloc_ptr_t memalign __MALLOC_P ((size_t __alignment, size_t __size));
 /* Allocate SIZE bytes on a page boundary.  */
 extern __malloc_ptr_t valloc __MALLOC_P ((size_t __size)) __attribute_malloc__;
 
-#ifdef __MALLOC_STANDARD__
+#if defined(__MALLOC_STANDARD__) || defined(__MALLOC_SLAB__)
 
 /* SVID2/XPG mallinfo structure */
 struct mallinfo {
@@ -148,15 +148,19 @@ struct mallinfo {
 extern struct mallinfo mallinfo __MALLOC_P ((void));
 libc_hidden_proto(mallinfo)
 
-/* Release all but __pad bytes of freed top-most memory back to the
-   system. Return 1 if successful, else 0. */
-extern int malloc_trim(size_t pad);
-
 #include <stdio.h>
 /* Prints brief summary statistics to the specified file.
  * Writes to stderr if file is NULL. */
 extern void malloc_stats(FILE *file);
 
+#endif /* __MALLOC_STANDARD__ || __MALLOC_SLAB__ */
+
+#ifdef __MALLOC_STANDARD__
+
+/* Release all but __pad bytes of freed top-most memory back to the
+   system. Return 1 if successful, else 0. */
+extern int malloc_trim(size_t pad);
+
 /* SVID2/XPG mallopt options */
 #ifndef M_MXFAST
 # define M_MXFAST  1	/* UNUSED in this malloc */
@@ -0,0 +1,30 @@
+/*
+ * malloc-slab: a size-class allocator for single-threaded programs.
+ *
+ * Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.
+ */
+
+#include "malloc.h"
+
+
+void *calloc(size_t n_elements, size_t elem_size)
+{
+	size_t size = n_elements * elem_size;
+	void *mem;
+
+	/* guard vs integer overflow, but allow nmemb
+	 * to fall through and call malloc(0) */
+	if (n_elements && elem_size != (size / n_elements)) {
+		__set_errno(ENOMEM);
+		return NULL;
+	}
+
+	/* A fresh mapping is clear already.  */
+	if (size > SLAB_MAX_SMALL - SLAB_HEADER)
+		return __slab_malloc_large(size, 1);
+
+	mem = malloc(size);
+	if (mem != NULL)
+		memset(mem, 0, size);
+	return mem;
+}
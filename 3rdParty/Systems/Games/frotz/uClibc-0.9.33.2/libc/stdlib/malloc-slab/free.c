@@ -0,0 +1,46 @@
+/*
+ * malloc-slab: a size-class allocator for single-threaded programs.
+ *
+ * Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.
+ */
+
+#include "malloc.h"
+
+
+void free(void *mem)
+{
+	struct slab_state *s = &__slab_state;
+	size_t header, len;
+	unsigned int c;
+
+	if (unlikely(mem == NULL))
+		return;
+
+	header = slab_header(mem);
+	if (likely((header & SLAB_TAGS) == 0)) {
+		c = header >> 2;
+		*(void **) mem = s->free_list[c];
+		s->free_list[c] = mem;
+		s->in_use[c]--;
+		s->cur_mem -= __slab_class_size[c];
+		return;
+	}
+
+	if (header & SLAB_ALIGNED) {
+		free((char *) mem - (header & ~SLAB_TAGS));
+		return;
+	}
+
+	len = header & ~SLAB_TAGS;
+	s->cur_mem -= len;
+	for (c = 0; c < SLAB_LARGE_CACHE; c++) {
+		if (s->large_cache[c] == NULL) {
+			s->large_cache[c] = mem;
+			s->cached_mem += len;
+			return;
+		}
+	}
+	s->n_mmaps--;
+	s->mmapped_mem -= len;
+	munmap((char *) mem - SLAB_LARGE_HEADER, len);
+}
@@ -0,0 +1,88 @@
+/*
+ * malloc-slab: a size-class allocator for single-threaded programs.
+ *
+ * Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.
+ */
+
+#include "malloc.h"
+
+
+/* Blocks on the free list for class C.  */
+static size_t slab_free_count(unsigned int c)
+{
+	size_t n = 0;
+	void *p;
+
+	for (p = __slab_state.free_list[c]; p != NULL; p = *(void **) p)
+		n++;
+	return n;
+}
+
+struct mallinfo mallinfo(void)
+{
+	struct slab_state *s = &__slab_state;
+	struct mallinfo mi;
+	size_t used = 0, nfree = 0, freemem = 0, n;
+	unsigned int c;
+
+	for (c = 0; c < SLAB_NCLASSES; c++) {
+		used += s->in_use[c] * __slab_class_size[c];
+		n = slab_free_count(c);
+		nfree += n;
+		freemem += n * __slab_class_size[c];
+	}
+
+	mi.arena = s->chunk_mem;
+	mi.ordblks = nfree;
+	mi.smblks = 0;
+	mi.hblks = s->n_mmaps;
+	mi.hblkhd = s->mmapped_mem;
+	mi.usmblks = s->max_mem;
+	mi.fsmblks = freemem;
+	mi.uordblks = used;
+	mi.fordblks = s->chunk_mem - used;
+	mi.keepcost = s->cached_mem;
+	return mi;
+}
+libc_hidden_def(mallinfo)
+
+void malloc_stats(FILE *file)
+{
+	struct slab_state *s = &__slab_state;
+	struct mallinfo mi;
+	unsigned int c;
+
+	if (file == NULL) {
+		file = stderr;
+	}
+
+	mi = mallinfo();
+	fprintf(file,
+	        "total bytes allocated             = %10u\n"
+	        "total bytes in use                = %10u\n"
+	        "total slab chunk space            = %10d\n"
+	        "number of mmapped regions         = %10d\n"
+	        "total allocated mmap space        = %10d\n"
+	        "maximum total allocated space     = %10d\n"
+	        "total free space                  = %10d\n"
+	        "freed large blocks kept mapped    = %10d\n",
+
+	        (unsigned int)(mi.arena + mi.hblkhd),
+	        (unsigned int)(mi.uordblks + mi.hblkhd - mi.keepcost),
+	        mi.arena,
+	        mi.hblks,
+	        mi.hblkhd,
+	        mi.usmblks,
+	        mi.fordblks,
+	        mi.keepcost
+	       );
+
+	for (c = 0; c < SLAB_NCLASSES; c++) {
+		if (s->in_use[c] == 0 && s->free_list[c] == NULL)
+			continue;
+		fprintf(file, "class %5u bytes: %8lu in use, %8lu free\n",
+		        (unsigned int) __slab_class_size[c],
+		        (unsigned long) s->in_use[c],
+		        (unsigned long) slab_free_count(c));
+	}
+}
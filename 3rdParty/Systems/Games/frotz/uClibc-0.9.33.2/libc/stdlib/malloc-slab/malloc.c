@@ -0,0 +1,167 @@
+/*
+ * malloc-slab: a size-class allocator for single-threaded programs.
+ *
+ * Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.
+ */
+
+#include "malloc.h"
+
+
+struct slab_state __slab_state;
+
+const unsigned int __slab_class_size[SLAB_NCLASSES] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024,
+	1280, 1536, 1792, 2048,
+	2560, 3072, 3584, 4096,
+	5120, 6144, 7168, 8192,
+	10240, 12288, 14336, 16384,
+	20480, 24576, 28672, 32768,
+	40960, 49152, 57344, 65536,
+	81920, 98304, 114688, 131072
+};
+
+/* Hand what is left of the current chunk to the free lists, largest
+   classes first, so that nothing but a few bytes are lost when we have
+   to move on to a new chunk.  */
+static void slab_spill(struct slab_state *s)
+{
+	unsigned int c = SLAB_NCLASSES;
+	char *mem;
+
+	while (c > 0) {
+		if ((size_t) (s->end - s->top) < __slab_class_size[c - 1]) {
+			c--;
+			continue;
+		}
+		mem = s->top + SLAB_HEADER;
+		slab_header(mem) = (c - 1) << 2;
+		*(void **) mem = s->free_list[c - 1];
+		s->free_list[c - 1] = mem;
+		s->top += __slab_class_size[c - 1];
+	}
+}
+
+/* Get a new chunk, preferably by growing the current one with brk.  */
+static int slab_grow(struct slab_state *s)
+{
+	char *chunk;
+
+	chunk = sbrk(SLAB_CHUNK_SIZE);
+	if (chunk != (char *) -1 && chunk == s->end) {
+		s->end += SLAB_CHUNK_SIZE;
+		s->chunk_mem += SLAB_CHUNK_SIZE;
+		return 0;
+	}
+	if (chunk == (char *) -1) {
+		chunk = mmap((void *) 0, SLAB_CHUNK_SIZE, PROT_READ | PROT_WRITE,
+		             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (chunk == MAP_FAILED)
+			return -1;
+	}
+	slab_spill(s);
+	s->chunk_mem += SLAB_CHUNK_SIZE;
+	s->end = chunk + SLAB_CHUNK_SIZE;
+
+	/* Blocks start SLAB_HEADER bytes below an aligned address, and all
+	   class sizes keep it that way.  */
+	s->top = (char *) (((uintptr_t) chunk + SLAB_HEADER
+	                    + MALLOC_ALIGNMENT - 1) & ~(MALLOC_ALIGNMENT - 1))
+	         - SLAB_HEADER;
+	return 0;
+}
+
+static void *slab_carve(struct slab_state *s, unsigned int c)
+{
+	size_t size = __slab_class_size[c];
+	char *mem;
+
+	if ((size_t) (s->end - s->top) < size && slab_grow(s) < 0)
+		return NULL;
+	mem = s->top + SLAB_HEADER;
+	slab_header(mem) = c << 2;
+	s->top += size;
+	return mem;
+}
+
+void *__slab_malloc_large(size_t bytes, int clear)
+{
+	struct slab_state *s = &__slab_state;
+	size_t len, cached;
+	unsigned int i;
+	char *map;
+
+	if (bytes > SIZE_MAX - SLAB_LARGE_HEADER - SLAB_PAGE_SIZE) {
+		__set_errno(ENOMEM);
+		return NULL;
+	}
+	len = (bytes + SLAB_LARGE_HEADER + SLAB_PAGE_SIZE - 1)
+	      & ~(size_t) (SLAB_PAGE_SIZE - 1);
+
+	/* A cached block will do if it is no more than twice the size.  */
+	for (i = 0; i < SLAB_LARGE_CACHE; i++) {
+		map = s->large_cache[i];
+		if (map == NULL)
+			continue;
+		cached = slab_header(map) & ~SLAB_TAGS;
+		if (cached >= len && cached / 2 <= len) {
+			s->large_cache[i] = NULL;
+			s->cached_mem -= cached;
+			if (clear)
+				memset(map, 0, bytes);
+			len = cached;
+			goto done;
+		}
+	}
+
+	map = mmap((void *) 0, len, PROT_READ | PROT_WRITE,
+	           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED)
+		return NULL;
+
+	map += SLAB_LARGE_HEADER;
+	slab_header(map) = len | SLAB_MMAPPED;
+	s->n_mmaps++;
+	s->mmapped_mem += len;
+done:
+	s->cur_mem += len;
+	if (s->cur_mem > s->max_mem)
+		s->max_mem = s->cur_mem;
+	return map;
+}
+
+void *malloc(size_t bytes)
+{
+	struct slab_state *s = &__slab_state;
+	unsigned int c;
+	void *mem;
+
+	if (unlikely(bytes == 0)) {
+#if defined(__MALLOC_GLIBC_COMPAT__)
+		bytes++;
+#else
+		/* Some programs will call malloc (0).  Lets be strict and return NULL */
+		__set_errno(ENOMEM);
+		return NULL;
+#endif
+	}
+	if (unlikely(bytes > SLAB_MAX_SMALL - SLAB_HEADER))
+		return __slab_malloc_large(bytes, 0);
+
+	c = slab_class(bytes);
+	mem = s->free_list[c];
+	if (likely(mem != NULL)) {
+		s->free_list[c] = *(void **) mem;
+	} else {
+		mem = slab_carve(s, c);
+		if (mem == NULL)
+			return NULL;
+	}
+	s->in_use[c]++;
+	s->cur_mem += __slab_class_size[c];
+	if (s->cur_mem > s->max_mem)
+		s->max_mem = s->cur_mem;
+	return mem;
+}
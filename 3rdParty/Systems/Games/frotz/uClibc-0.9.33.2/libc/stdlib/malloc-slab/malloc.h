@@ -0,0 +1,92 @@
+/*
+ * malloc-slab: a size-class allocator for single-threaded programs.
+ *
+ * Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.
+ */
+
+#include <features.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/*
+ * Every block starts with a size_t header just below the pointer handed
+ * to the caller, which is MALLOC_ALIGNMENT aligned.  The low two bits of
+ * the header say what kind of block it is:
+ *
+ *   0             carved from a slab chunk; the rest is the class << 2
+ *   SLAB_MMAPPED  a large block with an mmap of its own; the rest is the
+ *                 length of the mapping
+ *   SLAB_ALIGNED  a pointer returned by memalign into the middle of some
+ *                 other block; the rest is the distance back to it
+ *
+ * A free slab block keeps its header and holds the free list link in its
+ * first word, so malloc and free of a slab block never look anywhere but
+ * the block and the list head for its class.
+ */
+#define MALLOC_ALIGNMENT	(2 * sizeof(size_t))
+#define SLAB_HEADER		sizeof(size_t)
+#define SLAB_MMAPPED		1
+#define SLAB_ALIGNED		2
+#define SLAB_TAGS		(SLAB_MMAPPED | SLAB_ALIGNED)
+
+#define slab_header(mem)	(((size_t *) (mem))[-1])
+
+/* Sizes of the classes including the header: steps of 16 bytes up to
+   128, then four classes to each doubling up to SLAB_MAX_SMALL.  */
+#define SLAB_NCLASSES		48
+#define SLAB_MAX_SMALL		131072
+
+/* Slab chunks are taken from the system in units of this size.  */
+#define SLAB_CHUNK_SIZE		262144
+
+/* A large block's mapping starts with the header, padded so that the
+   caller's pointer is aligned.  */
+#define SLAB_LARGE_HEADER	MALLOC_ALIGNMENT
+#define SLAB_PAGE_SIZE		4096
+
+/* Freed large blocks kept mapped for reuse.  Getting a new mapping is
+   expensive under TempleLoader, which clears it, and a program that
+   frees a large block often wants another of about the same size.  */
+#define SLAB_LARGE_CACHE	4
+
+struct slab_state {
+	void *free_list[SLAB_NCLASSES];
+	size_t in_use[SLAB_NCLASSES];	/* blocks handed out, per class */
+
+	char *top;			/* unused tail of the current chunk */
+	char *end;
+	size_t chunk_mem;		/* bytes taken for slab chunks */
+
+	size_t n_mmaps;			/* large blocks, cached ones too */
+	size_t mmapped_mem;
+	char *large_cache[SLAB_LARGE_CACHE];
+	size_t cached_mem;
+
+	size_t cur_mem;			/* bytes in use, and the peak */
+	size_t max_mem;
+};
+
+extern struct slab_state __slab_state attribute_hidden;
+extern const unsigned int __slab_class_size[SLAB_NCLASSES] attribute_hidden;
+
+/* Large blocks, cleared if CLEAR is set.  */
+extern void *__slab_malloc_large(size_t bytes, int clear) attribute_hidden;
+
+/* Class for a request of SIZE bytes, which must be at least 1 and no
+   more than SLAB_MAX_SMALL - SLAB_HEADER.  */
+static __always_inline unsigned int slab_class(size_t size)
+{
+	size_t n = size + SLAB_HEADER - 1;
+	unsigned int bit;
+
+	if (n < 128)
+		return n >> 4;
+	bit = sizeof(long) * 8 - 1 - __builtin_clzl(n);
+	return 4 * bit - 24 + (n >> (bit - 2));
+}
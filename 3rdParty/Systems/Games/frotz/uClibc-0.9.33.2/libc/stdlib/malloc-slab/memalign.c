@@ -0,0 +1,40 @@
+/*
+ * malloc-slab: a size-class allocator for single-threaded programs.
+ *
+ * Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.
+ */
+
+#include "malloc.h"
+
+
+void *memalign(size_t alignment, size_t bytes)
+{
+	char *mem, *aligned;
+
+	if (alignment <= MALLOC_ALIGNMENT)
+		return malloc(bytes);
+
+	/* Make sure alignment is a power of two.  */
+	if (alignment & (alignment - 1)) {
+		size_t a = MALLOC_ALIGNMENT * 2;
+		while (a < alignment)
+			a <<= 1;
+		alignment = a;
+	}
+
+	if (bytes > SIZE_MAX - alignment) {
+		__set_errno(ENOMEM);
+		return NULL;
+	}
+	mem = malloc(bytes + alignment);
+	if (mem == NULL)
+		return NULL;
+
+	/* If MEM is not aligned already, the aligned pointer is at least
+	   MALLOC_ALIGNMENT bytes into the block, leaving room below it for
+	   a header that leads free back to MEM.  */
+	aligned = (char *) (((uintptr_t) mem + alignment - 1) & ~(alignment - 1));
+	if (aligned != mem)
+		slab_header(aligned) = (aligned - mem) | SLAB_ALIGNED;
+	return aligned;
+}
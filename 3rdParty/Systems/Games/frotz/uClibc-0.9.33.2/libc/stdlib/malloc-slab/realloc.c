@@ -0,0 +1,74 @@
+/*
+ * malloc-slab: a size-class allocator for single-threaded programs.
+ *
+ * Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.
+ */
+
+#include "malloc.h"
+
+
+/* Bytes the caller may use from MEM.  */
+static size_t slab_usable(void *mem)
+{
+	size_t header = slab_header(mem);
+
+	if ((header & SLAB_TAGS) == 0)
+		return __slab_class_size[header >> 2] - SLAB_HEADER;
+	if (header & SLAB_ALIGNED)
+		return slab_usable((char *) mem - (header & ~SLAB_TAGS))
+		       - (header & ~SLAB_TAGS);
+	return (header & ~SLAB_TAGS) - SLAB_LARGE_HEADER;
+}
+
+void *realloc(void *oldmem, size_t bytes)
+{
+	struct slab_state *s = &__slab_state;
+	size_t header, oldsize, len;
+	char *map;
+	void *mem;
+
+	if (oldmem == NULL)
+		return malloc(bytes);
+	if (bytes == 0) {
+		free(oldmem);
+		return NULL;
+	}
+
+	header = slab_header(oldmem);
+	oldsize = slab_usable(oldmem);
+
+	/* Stay put if the block is big enough and not more than about
+	   twice the size we would pick now.  */
+	if ((header & SLAB_TAGS) == 0 && bytes <= oldsize
+	    && (header >> 2) < slab_class(bytes) + 4)
+		return oldmem;
+
+	/* Large blocks stay large, and mremap can usually grow or shrink
+	   them without a copy.  */
+	if ((header & SLAB_MMAPPED) && bytes > SLAB_MAX_SMALL - SLAB_HEADER
+	    && bytes <= SIZE_MAX - SLAB_LARGE_HEADER - SLAB_PAGE_SIZE) {
+		len = (bytes + SLAB_LARGE_HEADER + SLAB_PAGE_SIZE - 1)
+		      & ~(size_t) (SLAB_PAGE_SIZE - 1);
+		if (len == (header & ~SLAB_TAGS))
+			return oldmem;
+		map = mremap((char *) oldmem - SLAB_LARGE_HEADER,
+		             header & ~SLAB_TAGS, len, MREMAP_MAYMOVE);
+		if (map == MAP_FAILED)
+			return NULL;
+
+		map += SLAB_LARGE_HEADER;
+		slab_header(map) = len | SLAB_MMAPPED;
+		s->mmapped_mem += len - (header & ~SLAB_TAGS);
+		s->cur_mem += len - (header & ~SLAB_TAGS);
+		if (s->cur_mem > s->max_mem)
+			s->max_mem = s->cur_mem;
+		return map;
+	}
+
+	mem = malloc(bytes);
+	if (mem == NULL)
+		return NULL;
+	memcpy(mem, oldmem, oldsize < bytes ? oldsize : bytes);
+	free(oldmem);
+	return mem;
+}
@@ -0,0 +1,141 @@
+/* Replay the allocation sequences of frotz and Doom against malloc and
+   report the time per call and the memory used.  This is a benchmark
+   rather than a test, so it is not run by "make check"; build it with
+   "make bench-malloc-replay" and run it by hand.
+
+   Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include <sys/time.h>
+
+struct replay_op
+{
+  char op;		/* 'm'alloc, 'c'alloc, 'r'ealloc or 'f'ree */
+  unsigned short block;
+  unsigned int size;
+};
+
+#include "bench-malloc-replay.h"
+
+/* Each time is the best of this many rounds.  */
+#define ROUNDS 5
+
+static void *blocks[FROTZ_SLOTS > DOOM_SLOTS ? FROTZ_SLOTS : DOOM_SLOTS];
+
+static double
+now (void)
+{
+  struct timeval tv;
+
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* Run the sequence once, touching the first byte of every block as the
+   program would.  Blocks still live at the end are kept so that the
+   caller can look at the heap; release () frees them.  */
+static int
+replay (const struct replay_op *ops, size_t n)
+{
+  size_t i;
+  char *p;
+
+  for (i = 0; i < n; ++i)
+    {
+      switch (ops[i].op)
+	{
+	case 'm':
+	  p = malloc (ops[i].size);
+	  break;
+	case 'c':
+	  p = calloc (1, ops[i].size);
+	  break;
+	case 'r':
+	  p = realloc (blocks[ops[i].block], ops[i].size);
+	  break;
+	default:
+	  free (blocks[ops[i].block]);
+	  blocks[ops[i].block] = NULL;
+	  continue;
+	}
+      if (p == NULL)
+	{
+	  printf ("allocation %lu of %u bytes failed\n",
+		  (unsigned long) i, ops[i].size);
+	  return 1;
+	}
+      *p = 1;
+      blocks[ops[i].block] = p;
+    }
+  return 0;
+}
+
+/* Free the blocks left over, returning how many there were.  */
+static size_t
+release (size_t nblocks)
+{
+  size_t i, n = 0;
+
+  for (i = 0; i < nblocks; ++i)
+    if (blocks[i] != NULL)
+      {
+	free (blocks[i]);
+	blocks[i] = NULL;
+	++n;
+      }
+  return n;
+}
+
+static int
+bench (const char *name, const struct replay_op *ops, size_t n,
+       size_t nblocks, unsigned reps)
+{
+  unsigned r, i;
+  size_t calls = n;
+  double t, best = 1e9;
+
+  for (r = 0; r < ROUNDS; ++r)
+    {
+      t = now ();
+      for (i = 0; i < reps; ++i)
+	{
+	  if (replay (ops, n))
+	    return 1;
+	  calls = n + release (nblocks);
+	}
+      t = now () - t;
+      if (t < best)
+	best = t;
+    }
+  printf ("%-6s %6lu calls %9.1f ns/call\n", name, (unsigned long) calls,
+	  best * 1e9 / ((double) reps * calls));
+
+#if defined(__MALLOC_STANDARD__) || defined(__MALLOC_SLAB__)
+  {
+    /* The heap at the end of the sequence.  */
+    struct mallinfo mi;
+
+    if (replay (ops, n))
+      return 1;
+    mi = mallinfo ();
+    printf ("       heap %d, in use %d, mmapped %d in %d, peak %d\n",
+	    mi.arena, mi.uordblks, mi.hblkhd, mi.hblks, mi.usmblks);
+    release (nblocks);
+  }
+#endif
+  return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  int ret = 0;
+
+  ret |= bench ("frotz", frotz_ops, sizeof (frotz_ops) / sizeof (frotz_ops[0]),
+		FROTZ_SLOTS, 200);
+  ret |= bench ("doom", doom_ops, sizeof (doom_ops) / sizeof (doom_ops[0]),
+		DOOM_SLOTS, 2000);
+  return ret;
+}
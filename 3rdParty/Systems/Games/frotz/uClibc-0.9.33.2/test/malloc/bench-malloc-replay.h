@@ -0,0 +1,729 @@
+/* Allocation sequences replayed by bench-malloc-replay.c.  Each entry
+   is an operation, a block number and a size; block numbers are reused
+   once the block has been freed.  */
+
+/* Traced from dfrotz playing detective.z5: start-up, then its first
+   1240 turns, each of which saves an undo snapshot and drops the oldest
+   once all 500 undo slots are full.  */
+#define FROTZ_SLOTS 511
+static const struct replay_op frotz_ops[] = {
+	{ 'm', 0, 4096 }, { 'm', 1, 472 }, { 'm', 2, 64 }, { 'm', 3, 4096 },
+	{ 'r', 2, 107576 }, { 'm', 4, 3600 }, { 'm', 5, 1800 },
+	{ 'm', 6, 34189 }, { 'm', 7, 4096 }, { 'm', 8, 4096 },
+	{ 'm', 9, 2070 }, { 'c', 10, 2048 }, { 'm', 11, 436 },
+	{ 'm', 12, 301 }, { 'm', 13, 691 }, { 'm', 14, 346 },
+	{ 'm', 15, 249 }, { 'm', 16, 211 }, { 'm', 17, 257 },
+	{ 'm', 18, 376 }, { 'm', 19, 267 }, { 'm', 20, 272 },
+	{ 'm', 21, 255 }, { 'm', 22, 308 }, { 'm', 23, 270 },
+	{ 'm', 24, 266 }, { 'm', 25, 253 }, { 'm', 26, 225 },
+	{ 'm', 27, 316 }, { 'm', 28, 271 }, { 'm', 29, 323 },
+	{ 'm', 30, 240 }, { 'm', 31, 294 }, { 'm', 32, 224 },
+	{ 'm', 33, 244 }, { 'm', 34, 253 }, { 'm', 35, 331 },
+	{ 'm', 36, 242 }, { 'm', 37, 211 }, { 'm', 38, 225 },
+	{ 'm', 39, 264 }, { 'm', 40, 310 }, { 'm', 41, 295 },
+	{ 'm', 42, 336 }, { 'm', 43, 355 }, { 'm', 44, 332 },
+	{ 'm', 45, 269 }, { 'm', 46, 290 }, { 'm', 47, 295 },
+	{ 'm', 48, 329 }, { 'm', 49, 355 }, { 'm', 50, 332 },
+	{ 'm', 51, 269 }, { 'm', 52, 290 }, { 'm', 53, 295 },
+	{ 'm', 54, 329 }, { 'm', 55, 355 }, { 'm', 56, 332 },
+	{ 'm', 57, 269 }, { 'm', 58, 290 }, { 'm', 59, 295 },
+	{ 'm', 60, 329 }, { 'm', 61, 355 }, { 'm', 62, 332 },
+	{ 'm', 63, 269 }, { 'm', 64, 290 }, { 'm', 65, 295 },
+	{ 'm', 66, 329 }, { 'm', 67, 355 }, { 'm', 68, 332 },
+	{ 'm', 69, 269 }, { 'm', 70, 290 }, { 'm', 71, 295 },
+	{ 'm', 72, 329 }, { 'm', 73, 355 }, { 'm', 74, 332 },
+	{ 'm', 75, 269 }, { 'm', 76, 290 }, { 'm', 77, 295 },
+	{ 'm', 78, 329 }, { 'm', 79, 355 }, { 'm', 80, 332 },
+	{ 'm', 81, 269 }, { 'm', 82, 290 }, { 'm', 83, 295 },
+	{ 'm', 84, 329 }, { 'm', 85, 355 }, { 'm', 86, 332 },
+	{ 'm', 87, 269 }, { 'm', 88, 290 }, { 'm', 89, 295 },
+	{ 'm', 90, 329 }, { 'm', 91, 355 }, { 'm', 92, 332 },
+	{ 'm', 93, 269 }, { 'm', 94, 290 }, { 'm', 95, 295 },
+	{ 'm', 96, 329 }, { 'm', 97, 355 }, { 'm', 98, 332 },
+	{ 'm', 99, 269 }, { 'm', 100, 290 }, { 'm', 101, 295 },
+	{ 'm', 102, 329 }, { 'm', 103, 355 }, { 'm', 104, 332 },
+	{ 'm', 105, 269 }, { 'm', 106, 290 }, { 'm', 107, 295 },
+	{ 'm', 108, 329 }, { 'm', 109, 355 }, { 'm', 110, 332 },
+	{ 'm', 111, 269 }, { 'm', 112, 290 }, { 'm', 113, 295 },
+	{ 'm', 114, 329 }, { 'm', 115, 355 }, { 'm', 116, 332 },
+	{ 'm', 117, 269 }, { 'm', 118, 290 }, { 'm', 119, 295 },
+	{ 'm', 120, 329 }, { 'm', 121, 355 }, { 'm', 122, 332 },
+	{ 'm', 123, 269 }, { 'm', 124, 290 }, { 'm', 125, 295 },
+	{ 'm', 126, 329 }, { 'm', 127, 355 }, { 'm', 128, 332 },
+	{ 'm', 129, 269 }, { 'm', 130, 290 }, { 'm', 131, 295 },
+	{ 'm', 132, 329 }, { 'm', 133, 355 }, { 'm', 134, 332 },
+	{ 'm', 135, 269 }, { 'm', 136, 290 }, { 'm', 137, 295 },
+	{ 'm', 138, 329 }, { 'm', 139, 355 }, { 'm', 140, 332 },
+	{ 'm', 141, 269 }, { 'm', 142, 290 }, { 'm', 143, 295 },
+	{ 'm', 144, 329 }, { 'm', 145, 355 }, { 'm', 146, 332 },
+	{ 'm', 147, 269 }, { 'm', 148, 290 }, { 'm', 149, 295 },
+	{ 'm', 150, 329 }, { 'm', 151, 355 }, { 'm', 152, 332 },
+	{ 'm', 153, 269 }, { 'm', 154, 290 }, { 'm', 155, 295 },
+	{ 'm', 156, 329 }, { 'm', 157, 355 }, { 'm', 158, 332 },
+	{ 'm', 159, 269 }, { 'm', 160, 290 }, { 'm', 161, 295 },
+	{ 'm', 162, 329 }, { 'm', 163, 355 }, { 'm', 164, 332 },
+	{ 'm', 165, 269 }, { 'm', 166, 290 }, { 'm', 167, 295 },
+	{ 'm', 168, 329 }, { 'm', 169, 355 }, { 'm', 170, 332 },
+	{ 'm', 171, 269 }, { 'm', 172, 290 }, { 'm', 173, 295 },
+	{ 'm', 174, 329 }, { 'm', 175, 355 }, { 'm', 176, 332 },
+	{ 'm', 177, 269 }, { 'm', 178, 290 }, { 'm', 179, 295 },
+	{ 'm', 180, 329 }, { 'm', 181, 355 }, { 'm', 182, 332 },
+	{ 'm', 183, 269 }, { 'm', 184, 290 }, { 'm', 185, 295 },
+	{ 'm', 186, 329 }, { 'm', 187, 355 }, { 'm', 188, 332 },
+	{ 'm', 189, 269 }, { 'm', 190, 290 }, { 'm', 191, 295 },
+	{ 'm', 192, 329 }, { 'm', 193, 355 }, { 'm', 194, 332 },
+	{ 'm', 195, 269 }, { 'm', 196, 290 }, { 'm', 197, 295 },
+	{ 'm', 198, 329 }, { 'm', 199, 355 }, { 'm', 200, 332 },
+	{ 'm', 201, 269 }, { 'm', 202, 290 }, { 'm', 203, 295 },
+	{ 'm', 204, 329 }, { 'm', 205, 355 }, { 'm', 206, 332 },
+	{ 'm', 207, 269 }, { 'm', 208, 290 }, { 'm', 209, 295 },
+	{ 'm', 210, 329 }, { 'm', 211, 355 }, { 'm', 212, 332 },
+	{ 'm', 213, 269 }, { 'm', 214, 290 }, { 'm', 215, 295 },
+	{ 'm', 216, 329 }, { 'm', 217, 355 }, { 'm', 218, 332 },
+	{ 'm', 219, 269 }, { 'm', 220, 290 }, { 'm', 221, 295 },
+	{ 'm', 222, 329 }, { 'm', 223, 355 }, { 'm', 224, 332 },
+	{ 'm', 225, 269 }, { 'm', 226, 290 }, { 'm', 227, 295 },
+	{ 'm', 228, 329 }, { 'm', 229, 355 }, { 'm', 230, 332 },
+	{ 'm', 231, 269 }, { 'm', 232, 290 }, { 'm', 233, 295 },
+	{ 'm', 234, 329 }, { 'm', 235, 355 }, { 'm', 236, 332 },
+	{ 'm', 237, 269 }, { 'm', 238, 290 }, { 'm', 239, 295 },
+	{ 'm', 240, 329 }, { 'm', 241, 355 }, { 'm', 242, 332 },
+	{ 'm', 243, 269 }, { 'm', 244, 290 }, { 'm', 245, 295 },
+	{ 'm', 246, 329 }, { 'm', 247, 355 }, { 'm', 248, 332 },
+	{ 'm', 249, 269 }, { 'm', 250, 290 }, { 'm', 251, 295 },
+	{ 'm', 252, 329 }, { 'm', 253, 355 }, { 'm', 254, 332 },
+	{ 'm', 255, 269 }, { 'm', 256, 290 }, { 'm', 257, 295 },
+	{ 'm', 258, 329 }, { 'm', 259, 355 }, { 'm', 260, 332 },
+	{ 'm', 261, 269 }, { 'm', 262, 290 }, { 'm', 263, 295 },
+	{ 'm', 264, 329 }, { 'm', 265, 355 }, { 'm', 266, 332 },
+	{ 'm', 267, 269 }, { 'm', 268, 290 }, { 'm', 269, 295 },
+	{ 'm', 270, 329 }, { 'm', 271, 355 }, { 'm', 272, 332 },
+	{ 'm', 273, 269 }, { 'm', 274, 290 }, { 'm', 275, 295 },
+	{ 'm', 276, 329 }, { 'm', 277, 355 }, { 'm', 278, 332 },
+	{ 'm', 279, 269 }, { 'm', 280, 290 }, { 'm', 281, 295 },
+	{ 'm', 282, 329 }, { 'm', 283, 355 }, { 'm', 284, 332 },
+	{ 'm', 285, 269 }, { 'm', 286, 290 }, { 'm', 287, 295 },
+	{ 'm', 288, 329 }, { 'm', 289, 355 }, { 'm', 290, 332 },
+	{ 'm', 291, 269 }, { 'm', 292, 290 }, { 'm', 293, 295 },
+	{ 'm', 294, 329 }, { 'm', 295, 355 }, { 'm', 296, 332 },
+	{ 'm', 297, 269 }, { 'm', 298, 290 }, { 'm', 299, 295 },
+	{ 'm', 300, 329 }, { 'm', 301, 355 }, { 'm', 302, 332 },
+	{ 'm', 303, 269 }, { 'm', 304, 290 }, { 'm', 305, 295 },
+	{ 'm', 306, 329 }, { 'm', 307, 355 }, { 'm', 308, 332 },
+	{ 'm', 309, 269 }, { 'm', 310, 290 }, { 'm', 311, 295 },
+	{ 'm', 312, 329 }, { 'm', 313, 355 }, { 'm', 314, 332 },
+	{ 'm', 315, 269 }, { 'm', 316, 290 }, { 'm', 317, 295 },
+	{ 'm', 318, 329 }, { 'm', 319, 355 }, { 'm', 320, 332 },
+	{ 'm', 321, 269 }, { 'm', 322, 290 }, { 'm', 323, 295 },
+	{ 'm', 324, 329 }, { 'm', 325, 355 }, { 'm', 326, 332 },
+	{ 'm', 327, 269 }, { 'm', 328, 290 }, { 'm', 329, 295 },
+	{ 'm', 330, 329 }, { 'm', 331, 355 }, { 'm', 332, 332 },
+	{ 'm', 333, 269 }, { 'm', 334, 290 }, { 'm', 335, 295 },
+	{ 'm', 336, 329 }, { 'm', 337, 355 }, { 'm', 338, 332 },
+	{ 'm', 339, 269 }, { 'm', 340, 290 }, { 'm', 341, 295 },
+	{ 'm', 342, 329 }, { 'm', 343, 355 }, { 'm', 344, 332 },
+	{ 'm', 345, 269 }, { 'm', 346, 290 }, { 'm', 347, 295 },
+	{ 'm', 348, 329 }, { 'm', 349, 355 }, { 'm', 350, 332 },
+	{ 'm', 351, 269 }, { 'm', 352, 290 }, { 'm', 353, 295 },
+	{ 'm', 354, 329 }, { 'm', 355, 355 }, { 'm', 356, 332 },
+	{ 'm', 357, 269 }, { 'm', 358, 290 }, { 'm', 359, 295 },
+	{ 'm', 360, 329 }, { 'm', 361, 355 }, { 'm', 362, 332 },
+	{ 'm', 363, 269 }, { 'm', 364, 290 }, { 'm', 365, 295 },
+	{ 'm', 366, 329 }, { 'm', 367, 355 }, { 'm', 368, 332 },
+	{ 'm', 369, 269 }, { 'm', 370, 290 }, { 'm', 371, 295 },
+	{ 'm', 372, 329 }, { 'm', 373, 355 }, { 'm', 374, 332 },
+	{ 'm', 375, 269 }, { 'm', 376, 290 }, { 'm', 377, 295 },
+	{ 'm', 378, 329 }, { 'm', 379, 355 }, { 'm', 380, 332 },
+	{ 'm', 381, 269 }, { 'm', 382, 290 }, { 'm', 383, 295 },
+	{ 'm', 384, 329 }, { 'm', 385, 355 }, { 'm', 386, 332 },
+	{ 'm', 387, 269 }, { 'm', 388, 290 }, { 'm', 389, 295 },
+	{ 'm', 390, 329 }, { 'm', 391, 355 }, { 'm', 392, 332 },
+	{ 'm', 393, 269 }, { 'm', 394, 290 }, { 'm', 395, 295 },
+	{ 'm', 396, 329 }, { 'm', 397, 355 }, { 'm', 398, 332 },
+	{ 'm', 399, 269 }, { 'm', 400, 290 }, { 'm', 401, 295 },
+	{ 'm', 402, 329 }, { 'm', 403, 355 }, { 'm', 404, 332 },
+	{ 'm', 405, 269 }, { 'm', 406, 290 }, { 'm', 407, 295 },
+	{ 'm', 408, 329 }, { 'm', 409, 355 }, { 'm', 410, 332 },
+	{ 'm', 411, 269 }, { 'm', 412, 290 }, { 'm', 413, 295 },
+	{ 'm', 414, 329 }, { 'm', 415, 355 }, { 'm', 416, 332 },
+	{ 'm', 417, 269 }, { 'm', 418, 290 }, { 'm', 419, 295 },
+	{ 'm', 420, 329 }, { 'm', 421, 355 }, { 'm', 422, 332 },
+	{ 'm', 423, 269 }, { 'm', 424, 290 }, { 'm', 425, 295 },
+	{ 'm', 426, 329 }, { 'm', 427, 355 }, { 'm', 428, 332 },
+	{ 'm', 429, 269 }, { 'm', 430, 290 }, { 'm', 431, 295 },
+	{ 'm', 432, 329 }, { 'm', 433, 355 }, { 'm', 434, 332 },
+	{ 'm', 435, 269 }, { 'm', 436, 290 }, { 'm', 437, 295 },
+	{ 'm', 438, 329 }, { 'm', 439, 355 }, { 'm', 440, 332 },
+	{ 'm', 441, 269 }, { 'm', 442, 290 }, { 'm', 443, 295 },
+	{ 'm', 444, 329 }, { 'm', 445, 355 }, { 'm', 446, 332 },
+	{ 'm', 447, 269 }, { 'm', 448, 290 }, { 'm', 449, 295 },
+	{ 'm', 450, 329 }, { 'm', 451, 355 }, { 'm', 452, 332 },
+	{ 'm', 453, 269 }, { 'm', 454, 290 }, { 'm', 455, 295 },
+	{ 'm', 456, 329 }, { 'm', 457, 355 }, { 'm', 458, 332 },
+	{ 'm', 459, 269 }, { 'm', 460, 290 }, { 'm', 461, 295 },
+	{ 'm', 462, 329 }, { 'm', 463, 355 }, { 'm', 464, 332 },
+	{ 'm', 465, 269 }, { 'm', 466, 290 }, { 'm', 467, 295 },
+	{ 'm', 468, 329 }, { 'm', 469, 355 }, { 'm', 470, 332 },
+	{ 'm', 471, 269 }, { 'm', 472, 290 }, { 'm', 473, 295 },
+	{ 'm', 474, 329 }, { 'm', 475, 355 }, { 'm', 476, 332 },
+	{ 'm', 477, 269 }, { 'm', 478, 290 }, { 'm', 479, 295 },
+	{ 'm', 480, 329 }, { 'm', 481, 355 }, { 'm', 482, 332 },
+	{ 'm', 483, 269 }, { 'm', 484, 290 }, { 'm', 485, 295 },
+	{ 'm', 486, 329 }, { 'm', 487, 355 }, { 'm', 488, 332 },
+	{ 'm', 489, 269 }, { 'm', 490, 290 }, { 'm', 491, 295 },
+	{ 'm', 492, 329 }, { 'm', 493, 355 }, { 'm', 494, 332 },
+	{ 'm', 495, 269 }, { 'm', 496, 290 }, { 'm', 497, 295 },
+	{ 'm', 498, 329 }, { 'm', 499, 355 }, { 'm', 500, 332 },
+	{ 'm', 501, 269 }, { 'm', 502, 290 }, { 'm', 503, 295 },
+	{ 'm', 504, 329 }, { 'm', 505, 355 }, { 'm', 506, 332 },
+	{ 'm', 507, 269 }, { 'm', 508, 290 }, { 'm', 509, 295 },
+	{ 'm', 510, 329 }, { 'f', 11, 0 }, { 'm', 11, 355 }, { 'f', 12, 0 },
+	{ 'm', 12, 332 }, { 'f', 13, 0 }, { 'm', 13, 269 }, { 'f', 14, 0 },
+	{ 'm', 14, 290 }, { 'f', 15, 0 }, { 'm', 15, 295 }, { 'f', 16, 0 },
+	{ 'm', 16, 329 }, { 'f', 17, 0 }, { 'm', 17, 355 }, { 'f', 18, 0 },
+	{ 'm', 18, 332 }, { 'f', 19, 0 }, { 'm', 19, 269 }, { 'f', 20, 0 },
+	{ 'm', 20, 290 }, { 'f', 21, 0 }, { 'm', 21, 295 }, { 'f', 22, 0 },
+	{ 'm', 22, 329 }, { 'f', 23, 0 }, { 'm', 23, 355 }, { 'f', 24, 0 },
+	{ 'm', 24, 332 }, { 'f', 25, 0 }, { 'm', 25, 269 }, { 'f', 26, 0 },
+	{ 'm', 26, 290 }, { 'f', 27, 0 }, { 'm', 27, 295 }, { 'f', 28, 0 },
+	{ 'm', 28, 329 }, { 'f', 29, 0 }, { 'm', 29, 355 }, { 'f', 30, 0 },
+	{ 'm', 30, 332 }, { 'f', 31, 0 }, { 'm', 31, 269 }, { 'f', 32, 0 },
+	{ 'm', 32, 290 }, { 'f', 33, 0 }, { 'm', 33, 295 }, { 'f', 34, 0 },
+	{ 'm', 34, 329 }, { 'f', 35, 0 }, { 'm', 35, 355 }, { 'f', 36, 0 },
+	{ 'm', 36, 332 }, { 'f', 37, 0 }, { 'm', 37, 269 }, { 'f', 38, 0 },
+	{ 'm', 38, 290 }, { 'f', 39, 0 }, { 'm', 39, 295 }, { 'f', 40, 0 },
+	{ 'm', 40, 329 }, { 'f', 41, 0 }, { 'm', 41, 355 }, { 'f', 42, 0 },
+	{ 'm', 42, 332 }, { 'f', 43, 0 }, { 'm', 43, 269 }, { 'f', 44, 0 },
+	{ 'm', 44, 290 }, { 'f', 45, 0 }, { 'm', 45, 295 }, { 'f', 46, 0 },
+	{ 'm', 46, 329 }, { 'f', 47, 0 }, { 'm', 47, 355 }, { 'f', 48, 0 },
+	{ 'm', 48, 332 }, { 'f', 49, 0 }, { 'm', 49, 269 }, { 'f', 50, 0 },
+	{ 'm', 50, 290 }, { 'f', 51, 0 }, { 'm', 51, 295 }, { 'f', 52, 0 },
+	{ 'm', 52, 329 }, { 'f', 53, 0 }, { 'm', 53, 355 }, { 'f', 54, 0 },
+	{ 'm', 54, 332 }, { 'f', 55, 0 }, { 'm', 55, 269 }, { 'f', 56, 0 },
+	{ 'm', 56, 290 }, { 'f', 57, 0 }, { 'm', 57, 295 }, { 'f', 58, 0 },
+	{ 'm', 58, 329 }, { 'f', 59, 0 }, { 'm', 59, 355 }, { 'f', 60, 0 },
+	{ 'm', 60, 332 }, { 'f', 61, 0 }, { 'm', 61, 269 }, { 'f', 62, 0 },
+	{ 'm', 62, 290 }, { 'f', 63, 0 }, { 'm', 63, 295 }, { 'f', 64, 0 },
+	{ 'm', 64, 329 }, { 'f', 65, 0 }, { 'm', 65, 355 }, { 'f', 66, 0 },
+	{ 'm', 66, 332 }, { 'f', 67, 0 }, { 'm', 67, 269 }, { 'f', 68, 0 },
+	{ 'm', 68, 290 }, { 'f', 69, 0 }, { 'm', 69, 295 }, { 'f', 70, 0 },
+	{ 'm', 70, 329 }, { 'f', 71, 0 }, { 'm', 71, 355 }, { 'f', 72, 0 },
+	{ 'm', 72, 332 }, { 'f', 73, 0 }, { 'm', 73, 269 }, { 'f', 74, 0 },
+	{ 'm', 74, 290 }, { 'f', 75, 0 }, { 'm', 75, 295 }, { 'f', 76, 0 },
+	{ 'm', 76, 329 }, { 'f', 77, 0 }, { 'm', 77, 355 }, { 'f', 78, 0 },
+	{ 'm', 78, 332 }, { 'f', 79, 0 }, { 'm', 79, 269 }, { 'f', 80, 0 },
+	{ 'm', 80, 290 }, { 'f', 81, 0 }, { 'm', 81, 295 }, { 'f', 82, 0 },
+	{ 'm', 82, 329 }, { 'f', 83, 0 }, { 'm', 83, 355 }, { 'f', 84, 0 },
+	{ 'm', 84, 332 }, { 'f', 85, 0 }, { 'm', 85, 269 }, { 'f', 86, 0 },
+	{ 'm', 86, 290 }, { 'f', 87, 0 }, { 'm', 87, 295 }, { 'f', 88, 0 },
+	{ 'm', 88, 329 }, { 'f', 89, 0 }, { 'm', 89, 355 }, { 'f', 90, 0 },
+	{ 'm', 90, 332 }, { 'f', 91, 0 }, { 'm', 91, 269 }, { 'f', 92, 0 },
+	{ 'm', 92, 290 }, { 'f', 93, 0 }, { 'm', 93, 295 }, { 'f', 94, 0 },
+	{ 'm', 94, 329 }, { 'f', 95, 0 }, { 'm', 95, 355 }, { 'f', 96, 0 },
+	{ 'm', 96, 332 }, { 'f', 97, 0 }, { 'm', 97, 269 }, { 'f', 98, 0 },
+	{ 'm', 98, 290 }, { 'f', 99, 0 }, { 'm', 99, 295 }, { 'f', 100, 0 },
+	{ 'm', 100, 329 }, { 'f', 101, 0 }, { 'm', 101, 355 },
+	{ 'f', 102, 0 }, { 'm', 102, 332 }, { 'f', 103, 0 },
+	{ 'm', 103, 269 }, { 'f', 104, 0 }, { 'm', 104, 290 },
+	{ 'f', 105, 0 }, { 'm', 105, 295 }, { 'f', 106, 0 },
+	{ 'm', 106, 329 }, { 'f', 107, 0 }, { 'm', 107, 355 },
+	{ 'f', 108, 0 }, { 'm', 108, 332 }, { 'f', 109, 0 },
+	{ 'm', 109, 269 }, { 'f', 110, 0 }, { 'm', 110, 290 },
+	{ 'f', 111, 0 }, { 'm', 111, 295 }, { 'f', 112, 0 },
+	{ 'm', 112, 329 }, { 'f', 113, 0 }, { 'm', 113, 355 },
+	{ 'f', 114, 0 }, { 'm', 114, 332 }, { 'f', 115, 0 },
+	{ 'm', 115, 269 }, { 'f', 116, 0 }, { 'm', 116, 290 },
+	{ 'f', 117, 0 }, { 'm', 117, 295 }, { 'f', 118, 0 },
+	{ 'm', 118, 329 }, { 'f', 119, 0 }, { 'm', 119, 355 },
+	{ 'f', 120, 0 }, { 'm', 120, 332 }, { 'f', 121, 0 },
+	{ 'm', 121, 269 }, { 'f', 122, 0 }, { 'm', 122, 290 },
+	{ 'f', 123, 0 }, { 'm', 123, 295 }, { 'f', 124, 0 },
+	{ 'm', 124, 329 }, { 'f', 125, 0 }, { 'm', 125, 355 },
+	{ 'f', 126, 0 }, { 'm', 126, 332 }, { 'f', 127, 0 },
+	{ 'm', 127, 269 }, { 'f', 128, 0 }, { 'm', 128, 290 },
+	{ 'f', 129, 0 }, { 'm', 129, 295 }, { 'f', 130, 0 },
+	{ 'm', 130, 329 }, { 'f', 131, 0 }, { 'm', 131, 355 },
+	{ 'f', 132, 0 }, { 'm', 132, 332 }, { 'f', 133, 0 },
+	{ 'm', 133, 269 }, { 'f', 134, 0 }, { 'm', 134, 290 },
+	{ 'f', 135, 0 }, { 'm', 135, 295 }, { 'f', 136, 0 },
+	{ 'm', 136, 329 }, { 'f', 137, 0 }, { 'm', 137, 355 },
+	{ 'f', 138, 0 }, { 'm', 138, 332 }, { 'f', 139, 0 },
+	{ 'm', 139, 269 }, { 'f', 140, 0 }, { 'm', 140, 290 },
+	{ 'f', 141, 0 }, { 'm', 141, 295 }, { 'f', 142, 0 },
+	{ 'm', 142, 329 }, { 'f', 143, 0 }, { 'm', 143, 355 },
+	{ 'f', 144, 0 }, { 'm', 144, 332 }, { 'f', 145, 0 },
+	{ 'm', 145, 269 }, { 'f', 146, 0 }, { 'm', 146, 290 },
+	{ 'f', 147, 0 }, { 'm', 147, 295 }, { 'f', 148, 0 },
+	{ 'm', 148, 329 }, { 'f', 149, 0 }, { 'm', 149, 355 },
+	{ 'f', 150, 0 }, { 'm', 150, 332 }, { 'f', 151, 0 },
+	{ 'm', 151, 269 }, { 'f', 152, 0 }, { 'm', 152, 290 },
+	{ 'f', 153, 0 }, { 'm', 153, 295 }, { 'f', 154, 0 },
+	{ 'm', 154, 329 }, { 'f', 155, 0 }, { 'm', 155, 355 },
+	{ 'f', 156, 0 }, { 'm', 156, 332 }, { 'f', 157, 0 },
+	{ 'm', 157, 269 }, { 'f', 158, 0 }, { 'm', 158, 290 },
+	{ 'f', 159, 0 }, { 'm', 159, 295 }, { 'f', 160, 0 },
+	{ 'm', 160, 329 }, { 'f', 161, 0 }, { 'm', 161, 355 },
+	{ 'f', 162, 0 }, { 'm', 162, 332 }, { 'f', 163, 0 },
+	{ 'm', 163, 269 }, { 'f', 164, 0 }, { 'm', 164, 290 },
+	{ 'f', 165, 0 }, { 'm', 165, 295 }, { 'f', 166, 0 },
+	{ 'm', 166, 329 }, { 'f', 167, 0 }, { 'm', 167, 355 },
+	{ 'f', 168, 0 }, { 'm', 168, 332 }, { 'f', 169, 0 },
+	{ 'm', 169, 269 }, { 'f', 170, 0 }, { 'm', 170, 290 },
+	{ 'f', 171, 0 }, { 'm', 171, 295 }, { 'f', 172, 0 },
+	{ 'm', 172, 329 }, { 'f', 173, 0 }, { 'm', 173, 355 },
+	{ 'f', 174, 0 }, { 'm', 174, 332 }, { 'f', 175, 0 },
+	{ 'm', 175, 269 }, { 'f', 176, 0 }, { 'm', 176, 290 },
+	{ 'f', 177, 0 }, { 'm', 177, 295 }, { 'f', 178, 0 },
+	{ 'm', 178, 329 }, { 'f', 179, 0 }, { 'm', 179, 355 },
+	{ 'f', 180, 0 }, { 'm', 180, 332 }, { 'f', 181, 0 },
+	{ 'm', 181, 269 }, { 'f', 182, 0 }, { 'm', 182, 290 },
+	{ 'f', 183, 0 }, { 'm', 183, 295 }, { 'f', 184, 0 },
+	{ 'm', 184, 329 }, { 'f', 185, 0 }, { 'm', 185, 355 },
+	{ 'f', 186, 0 }, { 'm', 186, 332 }, { 'f', 187, 0 },
+	{ 'm', 187, 269 }, { 'f', 188, 0 }, { 'm', 188, 290 },
+	{ 'f', 189, 0 }, { 'm', 189, 295 }, { 'f', 190, 0 },
+	{ 'm', 190, 329 }, { 'f', 191, 0 }, { 'm', 191, 355 },
+	{ 'f', 192, 0 }, { 'm', 192, 332 }, { 'f', 193, 0 },
+	{ 'm', 193, 269 }, { 'f', 194, 0 }, { 'm', 194, 290 },
+	{ 'f', 195, 0 }, { 'm', 195, 295 }, { 'f', 196, 0 },
+	{ 'm', 196, 329 }, { 'f', 197, 0 }, { 'm', 197, 355 },
+	{ 'f', 198, 0 }, { 'm', 198, 332 }, { 'f', 199, 0 },
+	{ 'm', 199, 269 }, { 'f', 200, 0 }, { 'm', 200, 290 },
+	{ 'f', 201, 0 }, { 'm', 201, 295 }, { 'f', 202, 0 },
+	{ 'm', 202, 329 }, { 'f', 203, 0 }, { 'm', 203, 355 },
+	{ 'f', 204, 0 }, { 'm', 204, 332 }, { 'f', 205, 0 },
+	{ 'm', 205, 269 }, { 'f', 206, 0 }, { 'm', 206, 290 },
+	{ 'f', 207, 0 }, { 'm', 207, 295 }, { 'f', 208, 0 },
+	{ 'm', 208, 329 }, { 'f', 209, 0 }, { 'm', 209, 355 },
+	{ 'f', 210, 0 }, { 'm', 210, 332 }, { 'f', 211, 0 },
+	{ 'm', 211, 269 }, { 'f', 212, 0 }, { 'm', 212, 290 },
+	{ 'f', 213, 0 }, { 'm', 213, 295 }, { 'f', 214, 0 },
+	{ 'm', 214, 329 }, { 'f', 215, 0 }, { 'm', 215, 355 },
+	{ 'f', 216, 0 }, { 'm', 216, 332 }, { 'f', 217, 0 },
+	{ 'm', 217, 269 }, { 'f', 218, 0 }, { 'm', 218, 290 },
+	{ 'f', 219, 0 }, { 'm', 219, 295 }, { 'f', 220, 0 },
+	{ 'm', 220, 329 }, { 'f', 221, 0 }, { 'm', 221, 355 },
+	{ 'f', 222, 0 }, { 'm', 222, 332 }, { 'f', 223, 0 },
+	{ 'm', 223, 269 }, { 'f', 224, 0 }, { 'm', 224, 290 },
+	{ 'f', 225, 0 }, { 'm', 225, 295 }, { 'f', 226, 0 },
+	{ 'm', 226, 329 }, { 'f', 227, 0 }, { 'm', 227, 355 },
+	{ 'f', 228, 0 }, { 'm', 228, 332 }, { 'f', 229, 0 },
+	{ 'm', 229, 269 }, { 'f', 230, 0 }, { 'm', 230, 290 },
+	{ 'f', 231, 0 }, { 'm', 231, 295 }, { 'f', 232, 0 },
+	{ 'm', 232, 329 }, { 'f', 233, 0 }, { 'm', 233, 355 },
+	{ 'f', 234, 0 }, { 'm', 234, 332 }, { 'f', 235, 0 },
+	{ 'm', 235, 269 }, { 'f', 236, 0 }, { 'm', 236, 290 },
+	{ 'f', 237, 0 }, { 'm', 237, 295 }, { 'f', 238, 0 },
+	{ 'm', 238, 329 }, { 'f', 239, 0 }, { 'm', 239, 355 },
+	{ 'f', 240, 0 }, { 'm', 240, 332 }, { 'f', 241, 0 },
+	{ 'm', 241, 271 }, { 'f', 242, 0 }, { 'm', 242, 290 },
+	{ 'f', 243, 0 }, { 'm', 243, 295 }, { 'f', 244, 0 },
+	{ 'm', 244, 329 }, { 'f', 245, 0 }, { 'm', 245, 355 },
+	{ 'f', 246, 0 }, { 'm', 246, 332 }, { 'f', 247, 0 },
+	{ 'm', 247, 269 }, { 'f', 248, 0 }, { 'm', 248, 290 },
+	{ 'f', 249, 0 }, { 'm', 249, 295 }, { 'f', 250, 0 },
+	{ 'm', 250, 329 }, { 'f', 251, 0 }, { 'm', 251, 355 },
+	{ 'f', 252, 0 }, { 'm', 252, 332 }, { 'f', 253, 0 },
+	{ 'm', 253, 269 }, { 'f', 254, 0 }, { 'm', 254, 290 },
+	{ 'f', 255, 0 }, { 'm', 255, 295 }, { 'f', 256, 0 },
+	{ 'm', 256, 329 }, { 'f', 257, 0 }, { 'm', 257, 355 },
+	{ 'f', 258, 0 }, { 'm', 258, 332 }, { 'f', 259, 0 },
+	{ 'm', 259, 269 }, { 'f', 260, 0 }, { 'm', 260, 290 },
+	{ 'f', 261, 0 }, { 'm', 261, 295 }, { 'f', 262, 0 },
+	{ 'm', 262, 329 }, { 'f', 263, 0 }, { 'm', 263, 355 },
+	{ 'f', 264, 0 }, { 'm', 264, 332 }, { 'f', 265, 0 },
+	{ 'm', 265, 269 }, { 'f', 266, 0 }, { 'm', 266, 290 },
+	{ 'f', 267, 0 }, { 'm', 267, 295 }, { 'f', 268, 0 },
+	{ 'm', 268, 329 }, { 'f', 269, 0 }, { 'm', 269, 355 },
+	{ 'f', 270, 0 }, { 'm', 270, 332 }, { 'f', 271, 0 },
+	{ 'm', 271, 269 }, { 'f', 272, 0 }, { 'm', 272, 290 },
+	{ 'f', 273, 0 }, { 'm', 273, 295 }, { 'f', 274, 0 },
+	{ 'm', 274, 329 }, { 'f', 275, 0 }, { 'm', 275, 355 },
+	{ 'f', 276, 0 }, { 'm', 276, 332 }, { 'f', 277, 0 },
+	{ 'm', 277, 269 }, { 'f', 278, 0 }, { 'm', 278, 290 },
+	{ 'f', 279, 0 }, { 'm', 279, 295 }, { 'f', 280, 0 },
+	{ 'm', 280, 329 }, { 'f', 281, 0 }, { 'm', 281, 355 },
+	{ 'f', 282, 0 }, { 'm', 282, 332 }, { 'f', 283, 0 },
+	{ 'm', 283, 269 }, { 'f', 284, 0 }, { 'm', 284, 290 },
+	{ 'f', 285, 0 }, { 'm', 285, 295 }, { 'f', 286, 0 },
+	{ 'm', 286, 329 }, { 'f', 287, 0 }, { 'm', 287, 355 },
+	{ 'f', 288, 0 }, { 'm', 288, 332 }, { 'f', 289, 0 },
+	{ 'm', 289, 269 }, { 'f', 290, 0 }, { 'm', 290, 290 },
+	{ 'f', 291, 0 }, { 'm', 291, 295 }, { 'f', 292, 0 },
+	{ 'm', 292, 329 }, { 'f', 293, 0 }, { 'm', 293, 355 },
+	{ 'f', 294, 0 }, { 'm', 294, 332 }, { 'f', 295, 0 },
+	{ 'm', 295, 269 }, { 'f', 296, 0 }, { 'm', 296, 290 },
+	{ 'f', 297, 0 }, { 'm', 297, 295 }, { 'f', 298, 0 },
+	{ 'm', 298, 329 }, { 'f', 299, 0 }, { 'm', 299, 355 },
+	{ 'f', 300, 0 }, { 'm', 300, 332 }, { 'f', 301, 0 },
+	{ 'm', 301, 269 }, { 'f', 302, 0 }, { 'm', 302, 290 },
+	{ 'f', 303, 0 }, { 'm', 303, 295 }, { 'f', 304, 0 },
+	{ 'm', 304, 329 }, { 'f', 305, 0 }, { 'm', 305, 355 },
+	{ 'f', 306, 0 }, { 'm', 306, 332 }, { 'f', 307, 0 },
+	{ 'm', 307, 269 }, { 'f', 308, 0 }, { 'm', 308, 290 },
+	{ 'f', 309, 0 }, { 'm', 309, 295 }, { 'f', 310, 0 },
+	{ 'm', 310, 329 }, { 'f', 311, 0 }, { 'm', 311, 355 },
+	{ 'f', 312, 0 }, { 'm', 312, 332 }, { 'f', 313, 0 },
+	{ 'm', 313, 269 }, { 'f', 314, 0 }, { 'm', 314, 290 },
+	{ 'f', 315, 0 }, { 'm', 315, 295 }, { 'f', 316, 0 },
+	{ 'm', 316, 329 }, { 'f', 317, 0 }, { 'm', 317, 355 },
+	{ 'f', 318, 0 }, { 'm', 318, 332 }, { 'f', 319, 0 },
+	{ 'm', 319, 269 }, { 'f', 320, 0 }, { 'm', 320, 290 },
+	{ 'f', 321, 0 }, { 'm', 321, 295 }, { 'f', 322, 0 },
+	{ 'm', 322, 329 }, { 'f', 323, 0 }, { 'm', 323, 355 },
+	{ 'f', 324, 0 }, { 'm', 324, 332 }, { 'f', 325, 0 },
+	{ 'm', 325, 269 }, { 'f', 326, 0 }, { 'm', 326, 290 },
+	{ 'f', 327, 0 }, { 'm', 327, 295 }, { 'f', 328, 0 },
+	{ 'm', 328, 329 }, { 'f', 329, 0 }, { 'm', 329, 355 },
+	{ 'f', 330, 0 }, { 'm', 330, 332 }, { 'f', 331, 0 },
+	{ 'm', 331, 269 }, { 'f', 332, 0 }, { 'm', 332, 290 },
+	{ 'f', 333, 0 }, { 'm', 333, 295 }, { 'f', 334, 0 },
+	{ 'm', 334, 329 }, { 'f', 335, 0 }, { 'm', 335, 355 },
+	{ 'f', 336, 0 }, { 'm', 336, 332 }, { 'f', 337, 0 },
+	{ 'm', 337, 269 }, { 'f', 338, 0 }, { 'm', 338, 290 },
+	{ 'f', 339, 0 }, { 'm', 339, 295 }, { 'f', 340, 0 },
+	{ 'm', 340, 329 }, { 'f', 341, 0 }, { 'm', 341, 355 },
+	{ 'f', 342, 0 }, { 'm', 342, 332 }, { 'f', 343, 0 },
+	{ 'm', 343, 269 }, { 'f', 344, 0 }, { 'm', 344, 290 },
+	{ 'f', 345, 0 }, { 'm', 345, 295 }, { 'f', 346, 0 },
+	{ 'm', 346, 329 }, { 'f', 347, 0 }, { 'm', 347, 355 },
+	{ 'f', 348, 0 }, { 'm', 348, 332 }, { 'f', 349, 0 },
+	{ 'm', 349, 269 }, { 'f', 350, 0 }, { 'm', 350, 290 },
+	{ 'f', 351, 0 }, { 'm', 351, 295 }, { 'f', 352, 0 },
+	{ 'm', 352, 329 }, { 'f', 353, 0 }, { 'm', 353, 355 },
+	{ 'f', 354, 0 }, { 'm', 354, 332 }, { 'f', 355, 0 },
+	{ 'm', 355, 269 }, { 'f', 356, 0 }, { 'm', 356, 290 },
+	{ 'f', 357, 0 }, { 'm', 357, 295 }, { 'f', 358, 0 },
+	{ 'm', 358, 329 }, { 'f', 359, 0 }, { 'm', 359, 355 },
+	{ 'f', 360, 0 }, { 'm', 360, 332 }, { 'f', 361, 0 },
+	{ 'm', 361, 269 }, { 'f', 362, 0 }, { 'm', 362, 290 },
+	{ 'f', 363, 0 }, { 'm', 363, 295 }, { 'f', 364, 0 },
+	{ 'm', 364, 329 }, { 'f', 365, 0 }, { 'm', 365, 355 },
+	{ 'f', 366, 0 }, { 'm', 366, 332 }, { 'f', 367, 0 },
+	{ 'm', 367, 269 }, { 'f', 368, 0 }, { 'm', 368, 290 },
+	{ 'f', 369, 0 }, { 'm', 369, 295 }, { 'f', 370, 0 },
+	{ 'm', 370, 329 }, { 'f', 371, 0 }, { 'm', 371, 355 },
+	{ 'f', 372, 0 }, { 'm', 372, 332 }, { 'f', 373, 0 },
+	{ 'm', 373, 269 }, { 'f', 374, 0 }, { 'm', 374, 290 },
+	{ 'f', 375, 0 }, { 'm', 375, 295 }, { 'f', 376, 0 },
+	{ 'm', 376, 329 }, { 'f', 377, 0 }, { 'm', 377, 355 },
+	{ 'f', 378, 0 }, { 'm', 378, 332 }, { 'f', 379, 0 },
+	{ 'm', 379, 269 }, { 'f', 380, 0 }, { 'm', 380, 290 },
+	{ 'f', 381, 0 }, { 'm', 381, 295 }, { 'f', 382, 0 },
+	{ 'm', 382, 329 }, { 'f', 383, 0 }, { 'm', 383, 355 },
+	{ 'f', 384, 0 }, { 'm', 384, 332 }, { 'f', 385, 0 },
+	{ 'm', 385, 269 }, { 'f', 386, 0 }, { 'm', 386, 290 },
+	{ 'f', 387, 0 }, { 'm', 387, 295 }, { 'f', 388, 0 },
+	{ 'm', 388, 329 }, { 'f', 389, 0 }, { 'm', 389, 355 },
+	{ 'f', 390, 0 }, { 'm', 390, 332 }, { 'f', 391, 0 },
+	{ 'm', 391, 269 }, { 'f', 392, 0 }, { 'm', 392, 290 },
+	{ 'f', 393, 0 }, { 'm', 393, 295 }, { 'f', 394, 0 },
+	{ 'm', 394, 329 }, { 'f', 395, 0 }, { 'm', 395, 355 },
+	{ 'f', 396, 0 }, { 'm', 396, 332 }, { 'f', 397, 0 },
+	{ 'm', 397, 269 }, { 'f', 398, 0 }, { 'm', 398, 290 },
+	{ 'f', 399, 0 }, { 'm', 399, 295 }, { 'f', 400, 0 },
+	{ 'm', 400, 329 }, { 'f', 401, 0 }, { 'm', 401, 355 },
+	{ 'f', 402, 0 }, { 'm', 402, 332 }, { 'f', 403, 0 },
+	{ 'm', 403, 269 }, { 'f', 404, 0 }, { 'm', 404, 290 },
+	{ 'f', 405, 0 }, { 'm', 405, 295 }, { 'f', 406, 0 },
+	{ 'm', 406, 329 }, { 'f', 407, 0 }, { 'm', 407, 355 },
+	{ 'f', 408, 0 }, { 'm', 408, 332 }, { 'f', 409, 0 },
+	{ 'm', 409, 269 }, { 'f', 410, 0 }, { 'm', 410, 290 },
+	{ 'f', 411, 0 }, { 'm', 411, 295 }, { 'f', 412, 0 },
+	{ 'm', 412, 329 }, { 'f', 413, 0 }, { 'm', 413, 355 },
+	{ 'f', 414, 0 }, { 'm', 414, 332 }, { 'f', 415, 0 },
+	{ 'm', 415, 269 }, { 'f', 416, 0 }, { 'm', 416, 290 },
+	{ 'f', 417, 0 }, { 'm', 417, 295 }, { 'f', 418, 0 },
+	{ 'm', 418, 329 }, { 'f', 419, 0 }, { 'm', 419, 355 },
+	{ 'f', 420, 0 }, { 'm', 420, 332 }, { 'f', 421, 0 },
+	{ 'm', 421, 269 }, { 'f', 422, 0 }, { 'm', 422, 290 },
+	{ 'f', 423, 0 }, { 'm', 423, 295 }, { 'f', 424, 0 },
+	{ 'm', 424, 329 }, { 'f', 425, 0 }, { 'm', 425, 355 },
+	{ 'f', 426, 0 }, { 'm', 426, 332 }, { 'f', 427, 0 },
+	{ 'm', 427, 269 }, { 'f', 428, 0 }, { 'm', 428, 290 },
+	{ 'f', 429, 0 }, { 'm', 429, 295 }, { 'f', 430, 0 },
+	{ 'm', 430, 329 }, { 'f', 431, 0 }, { 'm', 431, 355 },
+	{ 'f', 432, 0 }, { 'm', 432, 332 }, { 'f', 433, 0 },
+	{ 'm', 433, 269 }, { 'f', 434, 0 }, { 'm', 434, 290 },
+	{ 'f', 435, 0 }, { 'm', 435, 295 }, { 'f', 436, 0 },
+	{ 'm', 436, 329 }, { 'f', 437, 0 }, { 'm', 437, 355 },
+	{ 'f', 438, 0 }, { 'm', 438, 332 }, { 'f', 439, 0 },
+	{ 'm', 439, 269 }, { 'f', 440, 0 }, { 'm', 440, 290 },
+	{ 'f', 441, 0 }, { 'm', 441, 295 }, { 'f', 442, 0 },
+	{ 'm', 442, 329 }, { 'f', 443, 0 }, { 'm', 443, 355 },
+	{ 'f', 444, 0 }, { 'm', 444, 332 }, { 'f', 445, 0 },
+	{ 'm', 445, 269 }, { 'f', 446, 0 }, { 'm', 446, 290 },
+	{ 'f', 447, 0 }, { 'm', 447, 295 }, { 'f', 448, 0 },
+	{ 'm', 448, 329 }, { 'f', 449, 0 }, { 'm', 449, 355 },
+	{ 'f', 450, 0 }, { 'm', 450, 332 }, { 'f', 451, 0 },
+	{ 'm', 451, 269 }, { 'f', 452, 0 }, { 'm', 452, 290 },
+	{ 'f', 453, 0 }, { 'm', 453, 295 }, { 'f', 454, 0 },
+	{ 'm', 454, 329 }, { 'f', 455, 0 }, { 'm', 455, 355 },
+	{ 'f', 456, 0 }, { 'm', 456, 332 }, { 'f', 457, 0 },
+	{ 'm', 457, 269 }, { 'f', 458, 0 }, { 'm', 458, 290 },
+	{ 'f', 459, 0 }, { 'm', 459, 295 }, { 'f', 460, 0 },
+	{ 'm', 460, 329 }, { 'f', 461, 0 }, { 'm', 461, 355 },
+	{ 'f', 462, 0 }, { 'm', 462, 332 }, { 'f', 463, 0 },
+	{ 'm', 463, 269 }, { 'f', 464, 0 }, { 'm', 464, 290 },
+	{ 'f', 465, 0 }, { 'm', 465, 295 }, { 'f', 466, 0 },
+	{ 'm', 466, 329 }, { 'f', 467, 0 }, { 'm', 467, 355 },
+	{ 'f', 468, 0 }, { 'm', 468, 332 }, { 'f', 469, 0 },
+	{ 'm', 469, 269 }, { 'f', 470, 0 }, { 'm', 470, 290 },
+	{ 'f', 471, 0 }, { 'm', 471, 295 }, { 'f', 472, 0 },
+	{ 'm', 472, 329 }, { 'f', 473, 0 }, { 'm', 473, 355 },
+	{ 'f', 474, 0 }, { 'm', 474, 332 }, { 'f', 475, 0 },
+	{ 'm', 475, 269 }, { 'f', 476, 0 }, { 'm', 476, 290 },
+	{ 'f', 477, 0 }, { 'm', 477, 295 }, { 'f', 478, 0 },
+	{ 'm', 478, 329 }, { 'f', 479, 0 }, { 'm', 479, 355 },
+	{ 'f', 480, 0 }, { 'm', 480, 332 }, { 'f', 481, 0 },
+	{ 'm', 481, 269 }, { 'f', 482, 0 }, { 'm', 482, 290 },
+	{ 'f', 483, 0 }, { 'm', 483, 295 }, { 'f', 484, 0 },
+	{ 'm', 484, 329 }, { 'f', 485, 0 }, { 'm', 485, 355 },
+	{ 'f', 486, 0 }, { 'm', 486, 332 }, { 'f', 487, 0 },
+	{ 'm', 487, 269 }, { 'f', 488, 0 }, { 'm', 488, 290 },
+	{ 'f', 489, 0 }, { 'm', 489, 295 }, { 'f', 490, 0 },
+	{ 'm', 490, 329 }, { 'f', 491, 0 }, { 'm', 491, 355 },
+	{ 'f', 492, 0 }, { 'm', 492, 332 }, { 'f', 493, 0 },
+	{ 'm', 493, 269 }, { 'f', 494, 0 }, { 'm', 494, 290 },
+	{ 'f', 495, 0 }, { 'm', 495, 295 }, { 'f', 496, 0 },
+	{ 'm', 496, 329 }, { 'f', 497, 0 }, { 'm', 497, 355 },
+	{ 'f', 498, 0 }, { 'm', 498, 332 }, { 'f', 499, 0 },
+	{ 'm', 499, 269 }, { 'f', 500, 0 }, { 'm', 500, 290 },
+	{ 'f', 501, 0 }, { 'm', 501, 295 }, { 'f', 502, 0 },
+	{ 'm', 502, 329 }, { 'f', 503, 0 }, { 'm', 503, 355 },
+	{ 'f', 504, 0 }, { 'm', 504, 332 }, { 'f', 505, 0 },
+	{ 'm', 505, 269 }, { 'f', 506, 0 }, { 'm', 506, 290 },
+	{ 'f', 507, 0 }, { 'm', 507, 295 }, { 'f', 508, 0 },
+	{ 'm', 508, 329 }, { 'f', 509, 0 }, { 'm', 509, 355 },
+	{ 'f', 510, 0 }, { 'm', 510, 332 }, { 'f', 11, 0 }, { 'm', 11, 269 },
+	{ 'f', 12, 0 }, { 'm', 12, 290 }, { 'f', 13, 0 }, { 'm', 13, 295 },
+	{ 'f', 14, 0 }, { 'm', 14, 329 }, { 'f', 15, 0 }, { 'm', 15, 355 },
+	{ 'f', 16, 0 }, { 'm', 16, 332 }, { 'f', 17, 0 }, { 'm', 17, 269 },
+	{ 'f', 18, 0 }, { 'm', 18, 290 }, { 'f', 19, 0 }, { 'm', 19, 295 },
+	{ 'f', 20, 0 }, { 'm', 20, 329 }, { 'f', 21, 0 }, { 'm', 21, 355 },
+	{ 'f', 22, 0 }, { 'm', 22, 332 }, { 'f', 23, 0 }, { 'm', 23, 269 },
+	{ 'f', 24, 0 }, { 'm', 24, 290 }, { 'f', 25, 0 }, { 'm', 25, 295 },
+	{ 'f', 26, 0 }, { 'm', 26, 329 }, { 'f', 27, 0 }, { 'm', 27, 355 },
+	{ 'f', 28, 0 }, { 'm', 28, 332 }, { 'f', 29, 0 }, { 'm', 29, 269 },
+	{ 'f', 30, 0 }, { 'm', 30, 290 }, { 'f', 31, 0 }, { 'm', 31, 295 },
+	{ 'f', 32, 0 }, { 'm', 32, 329 }, { 'f', 33, 0 }, { 'm', 33, 355 },
+	{ 'f', 34, 0 }, { 'm', 34, 332 }, { 'f', 35, 0 }, { 'm', 35, 269 },
+	{ 'f', 36, 0 }, { 'm', 36, 290 }, { 'f', 37, 0 }, { 'm', 37, 295 },
+	{ 'f', 38, 0 }, { 'm', 38, 329 }, { 'f', 39, 0 }, { 'm', 39, 355 },
+	{ 'f', 40, 0 }, { 'm', 40, 332 }, { 'f', 41, 0 }, { 'm', 41, 269 },
+	{ 'f', 42, 0 }, { 'm', 42, 290 }, { 'f', 43, 0 }, { 'm', 43, 295 },
+	{ 'f', 44, 0 }, { 'm', 44, 329 }, { 'f', 45, 0 }, { 'm', 45, 355 },
+	{ 'f', 46, 0 }, { 'm', 46, 332 }, { 'f', 47, 0 }, { 'm', 47, 269 },
+	{ 'f', 48, 0 }, { 'm', 48, 290 }, { 'f', 49, 0 }, { 'm', 49, 295 },
+	{ 'f', 50, 0 }, { 'm', 50, 329 }, { 'f', 51, 0 }, { 'm', 51, 355 },
+	{ 'f', 52, 0 }, { 'm', 52, 332 }, { 'f', 53, 0 }, { 'm', 53, 269 },
+	{ 'f', 54, 0 }, { 'm', 54, 290 }, { 'f', 55, 0 }, { 'm', 55, 295 },
+	{ 'f', 56, 0 }, { 'm', 56, 329 }, { 'f', 57, 0 }, { 'm', 57, 355 },
+	{ 'f', 58, 0 }, { 'm', 58, 332 }, { 'f', 59, 0 }, { 'm', 59, 269 },
+	{ 'f', 60, 0 }, { 'm', 60, 290 }, { 'f', 61, 0 }, { 'm', 61, 295 },
+	{ 'f', 62, 0 }, { 'm', 62, 329 }, { 'f', 63, 0 }, { 'm', 63, 355 },
+	{ 'f', 64, 0 }, { 'm', 64, 332 }, { 'f', 65, 0 }, { 'm', 65, 269 },
+	{ 'f', 66, 0 }, { 'm', 66, 290 }, { 'f', 67, 0 }, { 'm', 67, 295 },
+	{ 'f', 68, 0 }, { 'm', 68, 329 }, { 'f', 69, 0 }, { 'm', 69, 355 },
+	{ 'f', 70, 0 }, { 'm', 70, 332 }, { 'f', 71, 0 }, { 'm', 71, 269 },
+	{ 'f', 72, 0 }, { 'm', 72, 290 }, { 'f', 73, 0 }, { 'm', 73, 295 },
+	{ 'f', 74, 0 }, { 'm', 74, 329 }, { 'f', 75, 0 }, { 'm', 75, 355 },
+	{ 'f', 76, 0 }, { 'm', 76, 332 }, { 'f', 77, 0 }, { 'm', 77, 269 },
+	{ 'f', 78, 0 }, { 'm', 78, 290 }, { 'f', 79, 0 }, { 'm', 79, 295 },
+	{ 'f', 80, 0 }, { 'm', 80, 329 }, { 'f', 81, 0 }, { 'm', 81, 355 },
+	{ 'f', 82, 0 }, { 'm', 82, 332 }, { 'f', 83, 0 }, { 'm', 83, 269 },
+	{ 'f', 84, 0 }, { 'm', 84, 290 }, { 'f', 85, 0 }, { 'm', 85, 295 },
+	{ 'f', 86, 0 }, { 'm', 86, 329 }, { 'f', 87, 0 }, { 'm', 87, 355 },
+	{ 'f', 88, 0 }, { 'm', 88, 332 }, { 'f', 89, 0 }, { 'm', 89, 269 },
+	{ 'f', 90, 0 }, { 'm', 90, 290 }, { 'f', 91, 0 }, { 'm', 91, 295 },
+	{ 'f', 92, 0 }, { 'm', 92, 329 }, { 'f', 93, 0 }, { 'm', 93, 355 },
+	{ 'f', 94, 0 }, { 'm', 94, 332 }, { 'f', 95, 0 }, { 'm', 95, 269 },
+	{ 'f', 96, 0 }, { 'm', 96, 290 }, { 'f', 97, 0 }, { 'm', 97, 295 },
+	{ 'f', 98, 0 }, { 'm', 98, 329 }, { 'f', 99, 0 }, { 'm', 99, 355 },
+	{ 'f', 100, 0 }, { 'm', 100, 332 }, { 'f', 101, 0 },
+	{ 'm', 101, 269 }, { 'f', 102, 0 }, { 'm', 102, 290 },
+	{ 'f', 103, 0 }, { 'm', 103, 295 }, { 'f', 104, 0 },
+	{ 'm', 104, 329 }, { 'f', 105, 0 }, { 'm', 105, 355 },
+	{ 'f', 106, 0 }, { 'm', 106, 332 }, { 'f', 107, 0 },
+	{ 'm', 107, 269 }, { 'f', 108, 0 }, { 'm', 108, 290 },
+	{ 'f', 109, 0 }, { 'm', 109, 295 }, { 'f', 110, 0 },
+	{ 'm', 110, 329 }, { 'f', 111, 0 }, { 'm', 111, 355 },
+	{ 'f', 112, 0 }, { 'm', 112, 332 }, { 'f', 113, 0 },
+	{ 'm', 113, 269 }, { 'f', 114, 0 }, { 'm', 114, 290 },
+	{ 'f', 115, 0 }, { 'm', 115, 295 }, { 'f', 116, 0 },
+	{ 'm', 116, 329 }, { 'f', 117, 0 }, { 'm', 117, 355 },
+	{ 'f', 118, 0 }, { 'm', 118, 332 }, { 'f', 119, 0 },
+	{ 'm', 119, 269 }, { 'f', 120, 0 }, { 'm', 120, 290 },
+	{ 'f', 121, 0 }, { 'm', 121, 295 }, { 'f', 122, 0 },
+	{ 'm', 122, 329 }, { 'f', 123, 0 }, { 'm', 123, 355 },
+	{ 'f', 124, 0 }, { 'm', 124, 332 }, { 'f', 125, 0 },
+	{ 'm', 125, 269 }, { 'f', 126, 0 }, { 'm', 126, 290 },
+	{ 'f', 127, 0 }, { 'm', 127, 295 }, { 'f', 128, 0 },
+	{ 'm', 128, 329 }, { 'f', 129, 0 }, { 'm', 129, 355 },
+	{ 'f', 130, 0 }, { 'm', 130, 332 }, { 'f', 131, 0 },
+	{ 'm', 131, 269 }, { 'f', 132, 0 }, { 'm', 132, 290 },
+	{ 'f', 133, 0 }, { 'm', 133, 295 }, { 'f', 134, 0 },
+	{ 'm', 134, 329 }, { 'f', 135, 0 }, { 'm', 135, 355 },
+	{ 'f', 136, 0 }, { 'm', 136, 332 }, { 'f', 137, 0 },
+	{ 'm', 137, 269 }, { 'f', 138, 0 }, { 'm', 138, 290 },
+	{ 'f', 139, 0 }, { 'm', 139, 295 }, { 'f', 140, 0 },
+	{ 'm', 140, 329 }, { 'f', 141, 0 }, { 'm', 141, 355 },
+	{ 'f', 142, 0 }, { 'm', 142, 332 }, { 'f', 143, 0 },
+	{ 'm', 143, 269 }, { 'f', 144, 0 }, { 'm', 144, 290 },
+	{ 'f', 145, 0 }, { 'm', 145, 295 }, { 'f', 146, 0 },
+	{ 'm', 146, 329 }, { 'f', 147, 0 }, { 'm', 147, 355 },
+	{ 'f', 148, 0 }, { 'm', 148, 332 }, { 'f', 149, 0 },
+	{ 'm', 149, 269 }, { 'f', 150, 0 }, { 'm', 150, 290 },
+	{ 'f', 151, 0 }, { 'm', 151, 295 }, { 'f', 152, 0 },
+	{ 'm', 152, 329 }, { 'f', 153, 0 }, { 'm', 153, 355 },
+	{ 'f', 154, 0 }, { 'm', 154, 332 }, { 'f', 155, 0 },
+	{ 'm', 155, 269 }, { 'f', 156, 0 }, { 'm', 156, 290 },
+	{ 'f', 157, 0 }, { 'm', 157, 295 }, { 'f', 158, 0 },
+	{ 'm', 158, 329 }, { 'f', 159, 0 }, { 'm', 159, 355 },
+	{ 'f', 160, 0 }, { 'm', 160, 332 }, { 'f', 161, 0 },
+	{ 'm', 161, 269 }, { 'f', 162, 0 }, { 'm', 162, 290 },
+	{ 'f', 163, 0 }, { 'm', 163, 295 }, { 'f', 164, 0 },
+	{ 'm', 164, 329 }, { 'f', 165, 0 }, { 'm', 165, 355 },
+	{ 'f', 166, 0 }, { 'm', 166, 332 }, { 'f', 167, 0 },
+	{ 'm', 167, 269 }, { 'f', 168, 0 }, { 'm', 168, 290 },
+	{ 'f', 169, 0 }, { 'm', 169, 295 }, { 'f', 170, 0 },
+	{ 'm', 170, 329 }, { 'f', 171, 0 }, { 'm', 171, 355 },
+	{ 'f', 172, 0 }, { 'm', 172, 332 }, { 'f', 173, 0 },
+	{ 'm', 173, 269 }, { 'f', 174, 0 }, { 'm', 174, 290 },
+	{ 'f', 175, 0 }, { 'm', 175, 295 }, { 'f', 176, 0 },
+	{ 'm', 176, 329 }, { 'f', 177, 0 }, { 'm', 177, 355 },
+	{ 'f', 178, 0 }, { 'm', 178, 332 }, { 'f', 179, 0 },
+	{ 'm', 179, 269 }, { 'f', 180, 0 }, { 'm', 180, 290 },
+	{ 'f', 181, 0 }, { 'm', 181, 295 }, { 'f', 182, 0 },
+	{ 'm', 182, 329 }, { 'f', 183, 0 }, { 'm', 183, 355 },
+	{ 'f', 184, 0 }, { 'm', 184, 332 }, { 'f', 185, 0 },
+	{ 'm', 185, 269 }, { 'f', 186, 0 }, { 'm', 186, 290 },
+	{ 'f', 187, 0 }, { 'm', 187, 295 }, { 'f', 188, 0 },
+	{ 'm', 188, 329 }, { 'f', 189, 0 }, { 'm', 189, 355 },
+	{ 'f', 190, 0 }, { 'm', 190, 332 }, { 'f', 191, 0 },
+	{ 'm', 191, 269 }, { 'f', 192, 0 }, { 'm', 192, 290 },
+	{ 'f', 193, 0 }, { 'm', 193, 295 }, { 'f', 194, 0 },
+	{ 'm', 194, 329 }, { 'f', 195, 0 }, { 'm', 195, 355 },
+	{ 'f', 196, 0 }, { 'm', 196, 332 }, { 'f', 197, 0 },
+	{ 'm', 197, 269 }, { 'f', 198, 0 }, { 'm', 198, 290 },
+	{ 'f', 199, 0 }, { 'm', 199, 295 }, { 'f', 200, 0 },
+	{ 'm', 200, 329 }, { 'f', 201, 0 }, { 'm', 201, 355 },
+	{ 'f', 202, 0 }, { 'm', 202, 332 }, { 'f', 203, 0 },
+	{ 'm', 203, 269 }, { 'f', 204, 0 }, { 'm', 204, 290 },
+	{ 'f', 205, 0 }, { 'm', 205, 295 }, { 'f', 206, 0 },
+	{ 'm', 206, 329 }, { 'f', 207, 0 }, { 'm', 207, 355 },
+	{ 'f', 208, 0 }, { 'm', 208, 332 }, { 'f', 209, 0 },
+	{ 'm', 209, 269 }, { 'f', 210, 0 }, { 'm', 210, 290 },
+	{ 'f', 211, 0 }, { 'm', 211, 295 }, { 'f', 212, 0 },
+	{ 'm', 212, 329 }, { 'f', 213, 0 }, { 'm', 213, 355 },
+	{ 'f', 214, 0 }, { 'm', 214, 332 }, { 'f', 215, 0 },
+	{ 'm', 215, 269 }, { 'f', 216, 0 }, { 'm', 216, 290 },
+	{ 'f', 217, 0 }, { 'm', 217, 295 }, { 'f', 218, 0 },
+	{ 'm', 218, 329 }, { 'f', 219, 0 }, { 'm', 219, 355 },
+	{ 'f', 220, 0 }, { 'm', 220, 332 }, { 'f', 221, 0 },
+	{ 'm', 221, 269 }, { 'f', 222, 0 }, { 'm', 222, 290 },
+	{ 'f', 223, 0 }, { 'm', 223, 295 }, { 'f', 224, 0 },
+	{ 'm', 224, 329 }, { 'f', 225, 0 }, { 'm', 225, 355 },
+	{ 'f', 226, 0 }, { 'm', 226, 332 }, { 'f', 227, 0 },
+	{ 'm', 227, 269 }, { 'f', 228, 0 }, { 'm', 228, 290 },
+	{ 'f', 229, 0 }, { 'm', 229, 295 }, { 'f', 230, 0 },
+	{ 'm', 230, 329 }, { 'f', 231, 0 }, { 'm', 231, 355 },
+	{ 'f', 232, 0 }, { 'm', 232, 332 }, { 'f', 233, 0 },
+	{ 'm', 233, 269 }, { 'f', 234, 0 }, { 'm', 234, 290 },
+	{ 'f', 235, 0 }, { 'm', 235, 295 }, { 'f', 236, 0 },
+	{ 'm', 236, 329 }, { 'f', 237, 0 }, { 'm', 237, 355 },
+	{ 'f', 238, 0 }, { 'm', 238, 332 }, { 'f', 239, 0 },
+	{ 'm', 239, 269 }, { 'f', 240, 0 }, { 'm', 240, 290 },
+	{ 'f', 241, 0 }, { 'm', 241, 295 }, { 'f', 242, 0 },
+	{ 'm', 242, 329 }, { 'f', 243, 0 }, { 'm', 243, 355 },
+	{ 'f', 244, 0 }, { 'm', 244, 332 }, { 'f', 245, 0 },
+	{ 'm', 245, 269 }, { 'f', 246, 0 }, { 'm', 246, 290 },
+	{ 'f', 247, 0 }, { 'm', 247, 295 }, { 'f', 248, 0 },
+	{ 'm', 248, 329 }, { 'f', 249, 0 }, { 'm', 249, 355 },
+	{ 'f', 250, 0 }, { 'm', 250, 332 }, { 'f', 251, 0 },
+	{ 'm', 251, 269 }, { 'f', 252, 0 }, { 'm', 252, 290 },
+	{ 'f', 253, 0 }, { 'm', 253, 295 }, { 'f', 254, 0 },
+	{ 'm', 254, 329 },
+};
+
+/* headless_doom with doom1.wad, which takes everything but a few blocks
+   from its zone: the calls made by D_DoomMain, V_Init, Z_Init,
+   W_InitMultipleFiles and R_InitTextures at start-up, then by
+   R_PrecacheLevel for each of the three demo levels.  Texture widths
+   are typical ones rather than those of the real textures.  */
+#define DOOM_SLOTS 15
+static const struct replay_op doom_ops[] = {
+	{ 'm', 0, 12 }, { 'm', 1, 11 }, { 'm', 2, 11 }, { 'm', 3, 12 },
+	{ 'm', 4, 15 }, { 'm', 5, 12 }, { 'm', 6, 13 }, { 'm', 7, 12 },
+	{ 'm', 8, 256000 }, { 'm', 9, 6291456 }, { 'm', 10, 1 },
+	{ 'm', 11, 20224 }, { 'r', 10, 25280 }, { 'f', 11, 0 },
+	{ 'm', 11, 10112 }, { 'm', 12, 1400 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 32 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 256 },
+	{ 'f', 13, 0 }, { 'm', 13, 64 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 128 }, { 'f', 13, 0 }, { 'm', 13, 64 },
+	{ 'f', 13, 0 }, { 'm', 13, 256 }, { 'f', 13, 0 }, { 'm', 13, 128 },
+	{ 'f', 13, 0 }, { 'f', 12, 0 }, { 'm', 12, 56 }, { 'm', 13, 125 },
+	{ 'm', 14, 138 }, { 'f', 12, 0 }, { 'f', 14, 0 }, { 'f', 13, 0 },
+	{ 'm', 13, 56 }, { 'm', 14, 125 }, { 'm', 12, 138 }, { 'f', 13, 0 },
+	{ 'f', 12, 0 }, { 'f', 14, 0 }, { 'm', 14, 56 }, { 'm', 12, 125 },
+	{ 'm', 13, 138 }, { 'f', 14, 0 }, { 'f', 13, 0 }, { 'f', 12, 0 },
+};
+
@@ -0,0 +1,161 @@
+/* Throughput of the string and memory functions for sizes from 1 byte
+   to 1 MB.  This is a benchmark rather than a test, so it is not run by
+   "make check"; build it with "make bench-string" and run it by hand.
+
+   Licensed under the LGPL v2.1, see the file COPYING.LIB in this tarball.  */
+
+/* Make sure we don't test the optimized inline functions if we want to
+   test the real implementation.  */
+#undef __USE_STRING_INLINES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define MAX_SIZE (1024 * 1024)
+
+/* Bytes moved per size, before the repeat count is capped.  */
+#define WORK (16 * 1024 * 1024)
+
+/* Each time is the best of this many rounds.  */
+#define ROUNDS 5
+
+static char *src, *dst;
+static volatile size_t sink;
+
+static double
+now (void)
+{
+  struct timeval tv;
+
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void
+do_memcpy (size_t n)
+{
+  sink += (size_t) memcpy (dst, src, n);
+}
+
+static void
+do_memmove (size_t n)
+{
+  /* Overlapping, in the direction that needs a backward copy.  */
+  sink += (size_t) memmove (src + 1, src, n);
+}
+
+static void
+do_memset (size_t n)
+{
+  sink += (size_t) memset (dst, n, n);
+}
+
+static void
+do_memcmp (size_t n)
+{
+  sink += memcmp (dst, src, n);
+}
+
+static void
+do_strlen (size_t n)
+{
+  sink += strlen (src);
+}
+
+static void
+do_strchr (size_t n)
+{
+  sink += (size_t) strchr (src, 'x');
+}
+
+static void
+do_strcmp (size_t n)
+{
+  sink += strcmp (dst, src);
+}
+
+static const struct
+{
+  const char *name;
+  void (*fn) (size_t);
+  int string;
+} funcs[] =
+{
+  { "memcpy", do_memcpy, 0 },
+  { "memmove", do_memmove, 0 },
+  { "memset", do_memset, 0 },
+  { "memcmp", do_memcmp, 0 },
+  { "strlen", do_strlen, 1 },
+  { "strchr", do_strchr, 1 },
+  { "strcmp", do_strcmp, 1 },
+};
+
+/* Fill both buffers so that memcmp and strcmp have to look at all N
+   bytes, and the strings end (and strchr finds its 'x') at byte N-1.  */
+static void
+prepare (size_t n, int string)
+{
+  size_t i;
+
+  for (i = 0; i < n + 1; ++i)
+    src[i] = dst[i] = 'a' + i % 23;
+  if (string)
+    {
+      src[n - 1] = dst[n - 1] = 'x';
+      src[n] = dst[n] = '\0';
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  size_t n, i, reps;
+  unsigned f, r;
+  double t, best;
+
+  src = malloc (MAX_SIZE + 64);
+  dst = malloc (MAX_SIZE + 64);
+  if (src == NULL || dst == NULL)
+    {
+      puts ("out of memory");
+      return 1;
+    }
+
+  printf ("%-8s", "size");
+  for (f = 0; f < sizeof (funcs) / sizeof (funcs[0]); ++f)
+    printf (" %9s", funcs[f].name);
+  printf ("\n%-8s", "");
+  for (f = 0; f < sizeof (funcs) / sizeof (funcs[0]); ++f)
+    printf (" %9s", "ns/call");
+  putchar ('\n');
+
+  for (n = 1; n <= MAX_SIZE; n *= 2)
+    {
+      reps = WORK / n;
+      if (reps > 200000)
+	reps = 200000;
+
+      printf ("%-8lu", (unsigned long) n);
+      for (f = 0; f < sizeof (funcs) / sizeof (funcs[0]); ++f)
+	{
+	  prepare (n, funcs[f].string);
+	  funcs[f].fn (n);
+	  best = 1e9;
+	  for (r = 0; r < ROUNDS; ++r)
+	    {
+	      t = now ();
+	      for (i = 0; i < reps; ++i)
+		funcs[f].fn (n);
+	      t = now () - t;
+	      if (t < best)
+		best = t;
+	    }
+	  printf (" %9.1f", best * 1e9 / reps);
+	}
+      putchar ('\n');
+    }
+
+  return 0;
+}
@@ -0,0 +1,8 @@
+#!/bin/bash -xe
+
+make -C uClibc-0.9.33.2
+cd tester
+as -o xmm.o xmm.s
+cd ..
+
+loader/build.sh xmmtest.prg tester/xmm.o